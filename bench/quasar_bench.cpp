@@ -0,0 +1,545 @@
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <dirent.h>
+#include <fcntl.h>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#include <sys/resource.h>
+#include "../src/SpatialPacker.h"
+#include "../src/ByteStream.h"
+#include "../src/CoefficientCodec.h"
+#include "../src/HaarTransform.h"
+#include "../src/SpatialFrame.h"
+#include "../lib/quasar_core/quasar_format.h"
+
+/**
+ * Quasar Bench
+ * Runs the spatial codec in-process over a GLB corpus (no UDP) and prints one JSON document:
+ * per file, per threshold, per stage latency percentiles and throughput, wire sizes per
+ * SpatialFrame section (the base frame packComponent sends), and the geometric error of the
+ * round trip (max / RMS vertex displacement and the symmetric vertex
+ * Hausdorff distance, absolute and relative to the bounding-box diagonal). Pipeline log output
+ * is discarded before any stage is timed, so timings exclude logging and stdout stays
+ * machine-readable. Every frame is also checked to decode to exactly what was encoded
+ * (coefficients, topology, primitive ranges); any mismatch makes the bench exit non-zero.
+ *
+ * Build (from the repo root, same sources as quasar-spatial minus main.cpp):
+ *   g++ -std=c++17 -O2 -pthread bench/quasar_bench.cpp $(find src lib/quasar_core -name '*.cpp') -o quasar-bench
+ * Usage:
+ *   quasar-bench <dir|file.glb> [--thresholds 0,0.001,0.01] [--levels <1-16>] [--bits <2-24>]
+ *                [--reorder <first-use|morton>] [--repeat <n>] [--output <file.json>]
+ */
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double elapsedMs(Clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+long peakRssKb() {
+    rusage usage = {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss;
+}
+
+// Latency samples and bytes processed for one pipeline stage
+struct StageStats {
+    std::vector<double> samples_ms;
+    double bytes = 0.0;
+    double vertices = 0.0;
+
+    double percentile(double p) const {
+        if (samples_ms.empty()) return 0.0;
+        std::vector<double> sorted = samples_ms;
+        std::sort(sorted.begin(), sorted.end());
+        const size_t rank = (size_t)std::ceil(p * (double)sorted.size());
+        return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+    }
+
+    double total() const {
+        double sum = 0.0;
+        for (double ms : samples_ms) sum += ms;
+        return sum;
+    }
+};
+
+struct ErrorStats {
+    double max = 0.0;
+    double rms = 0.0;
+    double hausdorff = 0.0;
+    double diagonal = 0.0;
+};
+
+/**
+ * Nearest-neighbour Aura Check:
+ * Hausdorff distance needs, for every point of one set, its nearest point in the other. A
+ * uniform grid with about one point per cell (cell = diagonal / cbrt(n)) answers that by
+ * visiting Chebyshev rings of cells outward from the query's cell; once the best distance is
+ * no larger than ring * cell, nothing unvisited can be closer.
+ */
+class PointGrid {
+public:
+    explicit PointGrid(const std::vector<float>& xyz) : xyz_(xyz) {
+        const size_t count = xyz.size() / 3;
+        for (int c = 0; c < 3; ++c) lo_[c] = hi_[c] = count ? xyz[c] : 0.0f;
+        for (size_t v = 0; v < count; ++v) {
+            for (int c = 0; c < 3; ++c) {
+                lo_[c] = std::min(lo_[c], xyz[v * 3 + c]);
+                hi_[c] = std::max(hi_[c], xyz[v * 3 + c]);
+            }
+        }
+        double diagonal = 0.0;
+        for (int c = 0; c < 3; ++c) diagonal += (double)(hi_[c] - lo_[c]) * (hi_[c] - lo_[c]);
+        diagonal = std::sqrt(diagonal);
+        cell_ = diagonal > 0.0 ? diagonal / std::max(1.0, std::cbrt((double)count)) : 1.0;
+        for (int c = 0; c < 3; ++c) dims_[c] = (int)((hi_[c] - lo_[c]) / cell_) + 1;
+
+        // CSR buckets: counting sort of points by cell
+        starts_.assign((size_t)dims_[0] * dims_[1] * dims_[2] + 1, 0);
+        for (size_t v = 0; v < count; ++v) ++starts_[cellOf(&xyz[v * 3]) + 1];
+        for (size_t i = 1; i < starts_.size(); ++i) starts_[i] += starts_[i - 1];
+        points_.resize(count);
+        std::vector<uint32_t> fill(starts_.begin(), starts_.end() - 1);
+        for (size_t v = 0; v < count; ++v) points_[fill[cellOf(&xyz[v * 3])]++] = (uint32_t)v;
+    }
+
+    // Distance from p to the closest point of the set (0 for an empty set)
+    double nearest(const float* p) const {
+        if (points_.empty()) return 0.0;
+        int home[3];
+        for (int c = 0; c < 3; ++c) home[c] = axisCell(p[c], c);
+
+        double best = INFINITY;
+        const int max_ring = std::max({dims_[0], dims_[1], dims_[2]});
+        for (int ring = 0; ring <= max_ring; ++ring) {
+            for (int x = home[0] - ring; x <= home[0] + ring; ++x) {
+                if (x < 0 || x >= dims_[0]) continue;
+                for (int y = home[1] - ring; y <= home[1] + ring; ++y) {
+                    if (y < 0 || y >= dims_[1]) continue;
+                    for (int z = home[2] - ring; z <= home[2] + ring; ++z) {
+                        if (z < 0 || z >= dims_[2]) continue;
+                        // Only the shell of this ring; inner cells were visited already
+                        if (std::max({std::abs(x - home[0]), std::abs(y - home[1]), std::abs(z - home[2])}) != ring) continue;
+                        const size_t cell = ((size_t)x * dims_[1] + y) * dims_[2] + z;
+                        for (uint32_t i = starts_[cell]; i < starts_[cell + 1]; ++i) {
+                            const float* q = &xyz_[(size_t)points_[i] * 3];
+                            const double dx = p[0] - q[0], dy = p[1] - q[1], dz = p[2] - q[2];
+                            best = std::min(best, dx * dx + dy * dy + dz * dz);
+                        }
+                    }
+                }
+            }
+            if (best <= (double)ring * cell_ * ring * cell_) break;
+        }
+        return std::sqrt(best);
+    }
+
+    double diagonal() const {
+        double sum = 0.0;
+        for (int c = 0; c < 3; ++c) sum += (double)(hi_[c] - lo_[c]) * (hi_[c] - lo_[c]);
+        return std::sqrt(sum);
+    }
+
+private:
+    int axisCell(float value, int c) const {
+        const double offset = ((double)value - lo_[c]) / cell_;
+        return offset <= 0.0 ? 0 : std::min(dims_[c] - 1, (int)offset);
+    }
+    size_t cellOf(const float* p) const {
+        return ((size_t)axisCell(p[0], 0) * dims_[1] + axisCell(p[1], 1)) * dims_[2] + axisCell(p[2], 2);
+    }
+
+    const std::vector<float>& xyz_;
+    float lo_[3], hi_[3];
+    double cell_ = 1.0;
+    int dims_[3] = {1, 1, 1};
+    std::vector<uint32_t> starts_;
+    std::vector<uint32_t> points_;
+};
+
+// Per-vertex displacement (same ordering on both sides) plus symmetric vertex Hausdorff distance
+void accumulateError(const std::vector<float>& original, const std::vector<float>& recovered, ErrorStats& error, double& squared_sum, size_t& samples) {
+    const size_t count = std::min(original.size(), recovered.size()) / 3;
+    for (size_t v = 0; v < count; ++v) {
+        double d2 = 0.0;
+        for (int c = 0; c < 3; ++c) {
+            const double d = (double)original[v * 3 + c] - recovered[v * 3 + c];
+            d2 += d * d;
+        }
+        error.max = std::max(error.max, std::sqrt(d2));
+        squared_sum += d2;
+    }
+    samples += count;
+
+    PointGrid original_grid(original), recovered_grid(recovered);
+    for (size_t v = 0; v < recovered.size() / 3; ++v) error.hausdorff = std::max(error.hausdorff, original_grid.nearest(&recovered[v * 3]));
+    for (size_t v = 0; v < original.size() / 3; ++v) error.hausdorff = std::max(error.hausdorff, recovered_grid.nearest(&original[v * 3]));
+    error.diagonal = std::max(error.diagonal, original_grid.diagonal());
+}
+
+// Minimal JSON emitter: locale-free shortest round-trip numbers via std::to_chars
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream& out) : out_(out) {}
+
+    void beginObject() { separate(); out_ << '{'; first_ = true; }
+    void endObject() { out_ << '}'; first_ = false; }
+    void beginArray() { separate(); out_ << '['; first_ = true; }
+    void endArray() { out_ << ']'; first_ = false; }
+
+    void key(const std::string& name) { separate(); string(name); out_ << ':'; first_ = true; }
+
+    void value(double number) {
+        separate();
+        if (!std::isfinite(number)) {
+            out_ << "null";
+            return;
+        }
+        char text[32];
+        out_.write(text, std::to_chars(text, text + sizeof(text), number).ptr - text);
+    }
+    void value(const std::string& text) { separate(); string(text); }
+    void value(bool flag) { separate(); out_ << (flag ? "true" : "false"); }
+
+    template <typename T>
+    void field(const std::string& name, const T& v) { key(name); value(v); }
+
+private:
+    void separate() {
+        if (!first_) out_ << ',';
+        first_ = false;
+    }
+    void string(const std::string& text) {
+        out_ << '"';
+        for (char ch : text) {
+            if (ch == '"' || ch == '\\') out_ << '\\';
+            if ((unsigned char)ch < 0x20) continue;
+            out_ << ch;
+        }
+        out_ << '"';
+    }
+
+    std::ostream& out_;
+    bool first_ = true;
+};
+
+void writeStage(JsonWriter& json, const std::string& name, const StageStats& stage) {
+    const double seconds = stage.total() / 1000.0;
+    json.key(name);
+    json.beginObject();
+    json.field("samples", (double)stage.samples_ms.size());
+    json.field("p50_ms", stage.percentile(0.50));
+    json.field("p90_ms", stage.percentile(0.90));
+    json.field("p99_ms", stage.percentile(0.99));
+    json.field("max_ms", stage.percentile(1.0));
+    json.field("mb_per_s", seconds > 0.0 ? stage.bytes / seconds / 1e6 : 0.0);
+    json.field("vertices_per_s", seconds > 0.0 ? stage.vertices / seconds : 0.0);
+    json.endObject();
+}
+
+// Wire bytes per section id (framing included) of a sectioned payload
+void sectionSizes(const std::vector<uint8_t>& payload, size_t* bytes) {
+    ByteReader reader(payload.data(), payload.size());
+    uint8_t version = 0;
+    if (!reader.readRaw(version)) return;
+    while (reader.remaining() > 0) {
+        const uint8_t* start = reader.ptr;
+        uint8_t id = 0;
+        uint32_t length = 0;
+        if (!reader.readRaw(id) || !reader.readVarint(length) || length > reader.remaining()) return;
+        reader.ptr += length;
+        if (id <= SpatialFrame::kSectionSession) bytes[id] += (size_t)(reader.ptr - start);
+    }
+}
+
+bool samePrimitives(const std::vector<PrimitiveRange>& a, const std::vector<PrimitiveRange>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t p = 0; p < a.size(); ++p) {
+        if (a[p].vertex_first != b[p].vertex_first || a[p].vertex_count != b[p].vertex_count ||
+            a[p].index_first != b[p].index_first || a[p].index_count != b[p].index_count) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Largest component-wise difference; infinite when one side lost the attribute
+double maxDifference(const std::vector<float>& a, const std::vector<float>& b) {
+    if (a.size() != b.size()) return INFINITY;
+    double worst = 0.0;
+    for (size_t i = 0; i < a.size(); ++i) worst = std::max(worst, std::abs((double)a[i] - b[i]));
+    return worst;
+}
+
+std::vector<std::string> listModels(const std::string& path) {
+    std::vector<std::string> models;
+    DIR* dir = opendir(path.c_str());
+    if (!dir) return {path};
+    while (dirent* entry = readdir(dir)) {
+        const std::string name = entry->d_name;
+        if (name.size() > 4 && name.compare(name.size() - 4, 4, ".glb") == 0) models.push_back(path + "/" + name);
+    }
+    closedir(dir);
+    std::sort(models.begin(), models.end());
+    return models;
+}
+
+std::vector<float> parseList(const std::string& text) {
+    std::vector<float> values;
+    size_t start = 0;
+    while (start <= text.size()) {
+        size_t end = text.find(',', start);
+        if (end == std::string::npos) end = text.size();
+        if (end > start) values.push_back(std::stof(text.substr(start, end - start)));
+        start = end + 1;
+    }
+    return values;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+    std::string corpus;
+    std::string output_path;
+    std::vector<float> thresholds = {0.0f, 0.001f, 0.01f, 0.05f};
+    int levels = 3;
+    int coefficient_bits = CoefficientCodec::kDefaultBits;
+    int repeat = 3;
+    bool morton_order = false;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--thresholds" && i + 1 < argc) {
+            thresholds = parseList(argv[++i]);
+        } else if (arg == "--levels" && i + 1 < argc) {
+            levels = std::clamp(std::stoi(argv[++i]), 1, kMaxHaarLevels);
+        } else if (arg == "--bits" && i + 1 < argc) {
+            coefficient_bits = std::stoi(argv[++i]);
+        } else if (arg == "--reorder" && i + 1 < argc) {
+            morton_order = std::string(argv[++i]) == "morton";
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            repeat = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--output" && i + 1 < argc) {
+            output_path = argv[++i];
+        } else if (corpus.empty()) {
+            corpus = arg;
+        }
+    }
+    if (corpus.empty() || thresholds.empty()) {
+        std::cerr << "Usage: quasar-bench <dir|file.glb> [--thresholds t1,t2,...] [--levels <1-16>] [--bits <2-24>]"
+                     " [--reorder <first-use|morton>] [--repeat <n>] [--output <file.json>]" << std::endl;
+        return 1;
+    }
+
+    // Pipeline stages log to std::cout (and quasar_core may use stdio): detach std::cout and point
+    // fd 1 at /dev/null before anything is timed, so no stage pays for formatting or terminal
+    // flushes. The JSON document is built in memory and written to the saved stdout at the end.
+    const int stdout_fd = dup(STDOUT_FILENO);
+    const int null_fd = open("/dev/null", O_WRONLY);
+    std::cout.flush();
+    std::fflush(stdout);
+    if (null_fd >= 0) {
+        dup2(null_fd, STDOUT_FILENO);
+        close(null_fd);
+    }
+    std::cout.rdbuf(nullptr);
+    std::ostringstream json_out;
+
+    JsonWriter json(json_out);
+    json.beginObject();
+    json.key("settings");
+    json.beginObject();
+    json.field("levels", (double)levels);
+    json.field("bits", (double)coefficient_bits);
+    json.field("reorder", std::string(morton_order ? "morton" : "first-use"));
+    json.field("repeat", (double)repeat);
+    json.endObject();
+
+    SpatialPacker packer;
+    bool round_trip_ok = true;
+    json.key("files");
+    json.beginArray();
+    for (const std::string& model : listModels(corpus)) {
+        std::cerr << "[Bench] " << model << std::endl;
+
+        // 1. Extraction
+        StageStats extract;
+        std::vector<MeshData> components;
+        for (int r = 0; r < repeat; ++r) {
+            const Clock::time_point start = Clock::now();
+            components = packer.extractMeshData(model.c_str());
+            extract.samples_ms.push_back(elapsedMs(start));
+        }
+        size_t vertex_count = 0, index_count = 0;
+        for (const MeshData& component : components) {
+            vertex_count += component.vertices.size() / 3;
+            index_count += component.indices.size();
+        }
+        extract.bytes = (double)(vertex_count * 3 * sizeof(float) + index_count * sizeof(uint32_t)) * repeat;
+        extract.vertices = (double)vertex_count * repeat;
+
+        json.beginObject();
+        json.field("path", model);
+        json.field("components", (double)components.size());
+        json.field("vertices", (double)vertex_count);
+        json.field("triangles", (double)(index_count / 3));
+        json.key("stages");
+        json.beginObject();
+        writeStage(json, "extract", extract);
+        json.endObject();
+
+        // 2. Threshold sweep: full TX + RX chain per component
+        json.key("sweep");
+        json.beginArray();
+        for (float threshold : thresholds) {
+            StageStats reorder, forward, encode_frame, decode_frame, inverse;
+            ErrorStats error;
+            double squared_sum = 0.0, normal_error = 0.0, texcoord_error = 0.0;
+            size_t error_samples = 0, zero_count = 0, coefficient_count = 0;
+            size_t raw_bytes = 0, frame_bytes = 0;
+            size_t section_bytes[SpatialFrame::kSectionSession + 1] = {};
+            bool lossless_topology = true, exact_positions = true, exact_layout = true;
+
+            for (int r = 0; r < repeat; ++r) {
+                for (const MeshData& source : components) {
+                    MeshData mesh = source;
+                    const double vertex_bytes = (double)mesh.vertices.size() * sizeof(float);
+                    const double index_bytes = (double)mesh.indices.size() * sizeof(uint32_t);
+                    const double attribute_bytes = (double)(mesh.normals.size() + mesh.texcoords.size()) * sizeof(float);
+                    const double vertices = (double)mesh.vertices.size() / 3;
+                    auto timed = [](StageStats& stage, double bytes, double verts, const std::function<void()>& work) {
+                        const Clock::time_point start = Clock::now();
+                        work();
+                        stage.samples_ms.push_back(elapsedMs(start));
+                        stage.bytes += bytes;
+                        stage.vertices += verts;
+                    };
+
+                    timed(reorder, vertex_bytes + index_bytes, vertices, [&] {
+                        if (morton_order) packer.reorderSpatially(mesh);
+                        else packer.optimizeTopology(mesh);
+                    });
+                    const std::vector<float> original = mesh.vertices;
+
+                    // Same payload packComponent sends: every section, positions included in full
+                    std::vector<uint8_t> payload;
+                    timed(forward, vertex_bytes, vertices, [&] { packer.compressMesh(mesh.vertices, threshold, levels); });
+                    timed(encode_frame, vertex_bytes + index_bytes + attribute_bytes, vertices, [&] {
+                        payload = SpatialFrame::encode(mesh, mesh.vertices.size(), coefficient_bits, levels);
+                    });
+
+                    MeshData recovered;
+                    size_t float_count = 0;
+                    int decoded_levels = 1;
+                    uint32_t epoch = 0;
+                    bool decoded = false;
+                    timed(decode_frame, vertex_bytes + index_bytes + attribute_bytes, vertices, [&] {
+                        decoded = SpatialFrame::decode(payload.data(), payload.size(), mesh.vertices.size() / 3, false, recovered,
+                                                       float_count, decoded_levels, epoch);
+                    });
+                    std::vector<float> coefficients = recovered.vertices;
+                    timed(inverse, vertex_bytes, vertices, [&] { packer.decompressMesh(recovered.vertices, decoded_levels); });
+
+                    // Sizes and error are identical across repeats; take them from the first pass
+                    if (r > 0) continue;
+                    raw_bytes += (size_t)(vertex_bytes + index_bytes + attribute_bytes);
+                    frame_bytes += sizeof(QuasarHeader) + payload.size();
+                    sectionSizes(payload, section_bytes);
+                    for (float c : mesh.vertices) zero_count += c == 0.0f;
+                    coefficient_count += mesh.vertices.size();
+
+                    // Round trip: the decoder must reproduce exactly what the encoder committed to
+                    float steps[3];
+                    std::vector<float> expected(mesh.vertices.size());
+                    CoefficientCodec::planeSteps(mesh.vertices.data(), mesh.vertices.size(), coefficient_bits, steps);
+                    CoefficientCodec::roundTrip(mesh.vertices.data(), mesh.vertices.size(), steps, expected.data());
+                    exact_positions = exact_positions && decoded && coefficients == expected && decoded_levels == levels;
+                    lossless_topology = lossless_topology && decoded && recovered.indices == mesh.indices;
+                    exact_layout = exact_layout && decoded && samePrimitives(SpatialPacker::primitiveRanges(recovered),
+                                                                             SpatialPacker::primitiveRanges(mesh));
+                    normal_error = std::max(normal_error, maxDifference(mesh.normals, recovered.normals));
+                    texcoord_error = std::max(texcoord_error, maxDifference(mesh.texcoords, recovered.texcoords));
+                    accumulateError(original, recovered.vertices, error, squared_sum, error_samples);
+                }
+            }
+            error.rms = error_samples ? std::sqrt(squared_sum / (double)error_samples) : 0.0;
+            round_trip_ok = round_trip_ok && exact_positions && lossless_topology && exact_layout;
+
+            json.beginObject();
+            json.field("threshold", (double)threshold);
+            json.key("sizes");
+            json.beginObject();
+            json.field("raw_bytes", (double)raw_bytes);
+            json.field("header_bytes", (double)(sizeof(QuasarHeader) * components.size()));
+            json.field("layout_bytes", (double)section_bytes[SpatialFrame::kSectionLayout]);
+            json.field("position_bytes", (double)section_bytes[SpatialFrame::kSectionPositions]);
+            json.field("topology_bytes", (double)section_bytes[SpatialFrame::kSectionTopology]);
+            json.field("normal_bytes", (double)section_bytes[SpatialFrame::kSectionNormals]);
+            json.field("texcoord_bytes", (double)section_bytes[SpatialFrame::kSectionTexcoords]);
+            json.field("compressed_bytes", (double)frame_bytes);
+            json.field("ratio", frame_bytes ? (double)raw_bytes / (double)frame_bytes : 0.0);
+            json.field("bits_per_vertex", vertex_count ? 8.0 * (double)frame_bytes / (double)vertex_count : 0.0);
+            json.field("zero_fraction", coefficient_count ? (double)zero_count / (double)coefficient_count : 0.0);
+            json.endObject();
+            json.key("error");
+            json.beginObject();
+            json.field("max", error.max);
+            json.field("rms", error.rms);
+            json.field("hausdorff", error.hausdorff);
+            json.field("hausdorff_relative", error.diagonal > 0.0 ? error.hausdorff / error.diagonal : 0.0);
+            json.field("normal_max", normal_error);
+            json.field("texcoord_max", texcoord_error);
+            json.field("topology_lossless", lossless_topology);
+            json.field("positions_exact", exact_positions);
+            json.field("primitives_exact", exact_layout);
+            json.endObject();
+            json.key("stages");
+            json.beginObject();
+            writeStage(json, "reorder", reorder);
+            writeStage(json, "wavelet_forward", forward);
+            writeStage(json, "frame_encode", encode_frame);
+            writeStage(json, "frame_decode", decode_frame);
+            writeStage(json, "wavelet_inverse", inverse);
+            json.endObject();
+            json.endObject();
+        }
+        json.endArray();
+        json.field("peak_rss_kb", (double)peakRssKb());
+        json.endObject();
+    }
+    json.endArray();
+    json.field("peak_rss_kb", (double)peakRssKb());
+    json.field("round_trip_ok", round_trip_ok);
+    json.endObject();
+    json_out << '\n';
+
+    const std::string document = json_out.str();
+    if (!output_path.empty()) {
+        std::ofstream output_file(output_path, std::ios::binary);
+        output_file << document;
+        if (!output_file) {
+            std::cerr << "[Bench] Failed to write " << output_path << std::endl;
+            return 1;
+        }
+    } else {
+        for (size_t written = 0; written < document.size();) {
+            const ssize_t n = write(stdout_fd, document.data() + written, document.size() - written);
+            if (n <= 0) return 1;
+            written += (size_t)n;
+        }
+    }
+    if (!round_trip_ok) {
+        std::cerr << "[Bench] Round trip mismatch: a decoded frame differs from what was encoded." << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -2,10 +2,16 @@
 #include <string>
 #include <vector>
 #include <cstring>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include "src/SpatialPacker.h"
+#include "src/CoefficientCodec.h"
+#include "src/TxPipeline.h"
+#include "src/RateControl.h"
+#include "src/RxPipeline.h"
+#include "src/HaarTransform.h"
 #include "lib/quasar_core/udp_link.h"
-#include "lib/quasar_core/quasar_format.h"
-#include "lib/quasar_core/huffman.h"
 
 /**
  * Quasar Spatial CLI
@@ -14,8 +20,9 @@
 
 void print_usage() {
     std::cout << "Usage:\n";
-    std::cout << "  TX: quasar-spatial --model <path> --tx <ip> <port> [--threshold <value>]\n";
-    std::cout << "  RX: quasar-spatial --rx <port>\n";
+    std::cout << "  TX: quasar-spatial --model <path> --tx <ip> <port> [--threshold <value>] [--bits <2-24>] [--levels <1-16>] [--jobs <n>] [--reorder <first-use|morton>] [--progressive]\n";
+    std::cout << "      [--stream <passes>] [--keyframe <n>] [--interval <ms>] [--max-error <value> | --bitrate <bytes per pass>]\n";
+    std::cout << "  RX: quasar-spatial --rx <port> [--jobs <n>] [--export <obj|glb|blob>]\n";
 }
 
 int main(int argc, char* argv[]) {
@@ -25,6 +32,17 @@ int main(int argc, char* argv[]) {
     int tx_port = 0;
     int rx_port = 0;
     float threshold = 0.01f;
+    int coefficient_bits = CoefficientCodec::kDefaultBits;
+    int levels = 1;
+    int jobs = 1;
+    bool morton_order = false;
+    bool progressive = false;
+    ExportFormat export_format = ExportFormat::OBJ;
+    int passes = 1;
+    int keyframe_interval = 30;
+    int interval_ms = 0;
+    float max_error = 0.0f;
+    size_t byte_budget = 0;
     bool rx_mode = false;
 
     for (int i = 1; i < argc; ++i) {
@@ -39,63 +57,49 @@ int main(int argc, char* argv[]) {
             rx_mode = true;
         } else if (arg == "--threshold" && i + 1 < argc) {
             threshold = std::stof(argv[++i]);
+        } else if (arg == "--bits" && i + 1 < argc) {
+            coefficient_bits = std::stoi(argv[++i]);
+        } else if (arg == "--levels" && i + 1 < argc) {
+            levels = std::clamp(std::stoi(argv[++i]), 1, kMaxHaarLevels);
+        } else if (arg == "--jobs" && i + 1 < argc) {
+            jobs = std::stoi(argv[++i]);
+        } else if (arg == "--reorder" && i + 1 < argc) {
+            morton_order = std::string(argv[++i]) == "morton";
+        } else if (arg == "--progressive") {
+            progressive = true;
+        } else if (arg == "--export" && i + 1 < argc) {
+            std::string format = argv[++i];
+            export_format = format == "glb" ? ExportFormat::GLB : format == "blob" ? ExportFormat::Blob : ExportFormat::OBJ;
+        } else if (arg == "--stream" && i + 1 < argc) {
+            passes = std::max(1, std::stoi(argv[++i]));
+        } else if (arg == "--keyframe" && i + 1 < argc) {
+            keyframe_interval = std::stoi(argv[++i]);
+        } else if (arg == "--interval" && i + 1 < argc) {
+            interval_ms = std::stoi(argv[++i]);
+        } else if (arg == "--max-error" && i + 1 < argc) {
+            max_error = std::stof(argv[++i]);
+        } else if (arg == "--bitrate" && i + 1 < argc) {
+            byte_budget = (size_t)std::stoull(argv[++i]);
         }
     }
 
     SpatialPacker packer;
-    HuffmanCodec librarian;
 
     if (rx_mode) {
         std::cout << "Starting Quasar-Spatial GCS Receiver on port " << rx_port << "..." << std::endl;
-        QuasarRx receiver;
-        std::vector<uint8_t> frame_raw;
-
-        while (true) {
-            if (receiver.listen(rx_port, frame_raw)) {
-                if (frame_raw.size() < sizeof(QuasarHeader)) continue;
-
-                QuasarHeader* header = reinterpret_cast<QuasarHeader*>(frame_raw.data());
-                if (std::string(header->magic, 4) != "QSR1") continue;
-
-                if (header->file_type == 0x03) {
-                    std::cout << "\n[Receiver] Incoming Spatial Frame (Target: " << header->target_id << ")" << std::endl;
-                    
-                    size_t vertex_count = header->width; 
-size_t vertex_bytes = vertex_count * sizeof(float);
-                    
-                    // 1. Separate Payload
-                    uint8_t* payload_ptr = frame_raw.data() + sizeof(QuasarHeader);
-                    
-                    // Extract Vertices
-                    if (frame_raw.size() < sizeof(QuasarHeader) + vertex_bytes) continue;
-                    std::vector<float> recovered_vertices(vertex_count);
-                    std::memcpy(recovered_vertices.data(), payload_ptr, vertex_bytes);
-                    
-                    // Extract Huffman-compressed Indices
-                    size_t huffman_bytes = frame_raw.size() - sizeof(QuasarHeader) - vertex_bytes;
-                    std::vector<uint8_t> huffman_indices(huffman_bytes);
-                    std::memcpy(huffman_indices.data(), payload_ptr + vertex_bytes, huffman_bytes);
-
-                    // 2. Decompress Indices (Librarian)
-                    std::cout << "[Receiver] Decompressing topology..." << std::endl;
-                    std::vector<uint8_t> index_raw = librarian.decompress(huffman_indices);
-                    std::vector<uint32_t> recovered_indices(index_raw.size() / sizeof(uint32_t));
-                    std::memcpy(recovered_indices.data(), index_raw.data(), index_raw.size());
-
-                    // 3. Decompress Vertices (Inverse Wavelet)
-                    packer.decompressMesh(recovered_vertices);
-
-                    // 4. Export to OBJ
-                    std::string export_name = "recovered_mesh_" + std::to_string(header->target_id) + ".obj";
-                    SpatialPacker::saveAsOBJ(export_name, recovered_vertices, recovered_indices);
-                }
-            }
-        }
+
+        // Socket thread reassembles frames; decode + export run on std::max(jobs, 1) workers
+        RxPipeline pipeline(rx_port, std::max(jobs, 1), export_format);
+        if (!pipeline.run()) return 1;
     } else {
         if (model_path.empty() || target_ip.empty() || tx_port == 0) {
             print_usage();
             return 1;
         }
+        if (max_error > 0.0f && byte_budget > 0) {
+            std::cerr << "--max-error and --bitrate are alternatives; pass only one." << std::endl;
+            return 1;
+        }
 
         std::cout << "Initializing Quasar Spatial TX Pipeline..." << std::endl;
 
@@ -109,44 +113,60 @@ size_t vertex_bytes = vertex_count * sizeof(float);
         }
 
         QuasarTx transmitter;
-        uint32_t current_target_id = 0;
-
-        for (auto& component : components) {
-            std::cout << "\nProcessing Component [" << current_target_id << "]: " << component.name << std::endl;
-            
-            // --- VERTEX PATH (Signal Logic) ---
-            size_t original_vertex_bytes = component.vertices.size() * sizeof(float);
-            packer.compressMesh(component.vertices, threshold);
-            
-            // --- INDEX PATH (Discrete Logic) ---
-            std::vector<uint8_t> index_bytes(component.indices.size() * sizeof(uint32_t));
-            std::memcpy(index_bytes.data(), component.indices.data(), index_bytes.size());
-            
-            std::cout << "Compressing indices (" << component.indices.size() << ") using Librarian (Huffman)..." << std::endl;
-            std::vector<uint8_t> huffman_indices = librarian.compress(index_bytes);
-
-            // --- THE QUASAR BRIDGE ---
-            QuasarHeader header = {};
-            std::memcpy(header.magic, "QSR1", 4);
-            header.file_type = 0x03; // Spatial/Mesh
-            header.original_size = original_vertex_bytes + index_bytes.size();
-            header.compression_flags = 0x03; // Wavelet + Huffman
-            header.scale = 1.0f;
-            header.target_id = current_target_id++;
-            header.width = (uint32_t)component.vertices.size(); // Store vertex count for receiver
-
-            // Final payload: Header + Vertices (Wavelet) + Indices (Huffman)
-            size_t vertex_payload_size = component.vertices.size() * sizeof(float);
-            size_t index_payload_size = huffman_indices.size();
-
-            std::vector<uint8_t> packet_data(sizeof(QuasarHeader) + vertex_payload_size + index_payload_size);
-            std::memcpy(packet_data.data(), &header, sizeof(QuasarHeader));
-            std::memcpy(packet_data.data() + sizeof(QuasarHeader), component.vertices.data(), vertex_payload_size);
-            std::memcpy(packet_data.data() + sizeof(QuasarHeader) + vertex_payload_size, huffman_indices.data(), index_payload_size);
-
-            // 4. Transmit Component
-            std::cout << "Transmitting component payload: " << packet_data.size() << " bytes." << std::endl;
+        TxSettings settings;
+        settings.threshold = threshold;
+        settings.coefficient_bits = coefficient_bits;
+        settings.levels = levels;
+        settings.morton_order = morton_order;
+        settings.progressive = progressive;
+
+        // Session mode: repeated passes send keyframes, then residuals against the receiver's cache
+        DeltaSessions sessions(keyframe_interval);
+        DeltaSessions* session_state = passes > 1 ? &sessions : nullptr;
+        if (session_state && progressive) {
+            std::cout << "Streaming session: --progressive applies to single passes only, sending full keyframes." << std::endl;
+        }
+
+        auto send = [&](const std::vector<uint8_t>& packet_data) {
             transmitter.send_frame(packet_data, target_ip, tx_port);
+        };
+
+        for (int pass = 0; pass < passes; ++pass) {
+            if (pass > 0) {
+                if (interval_ms > 0) std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+                // Re-extract so changes to the model on disk (moving joints, deforming parts) are picked up
+                components = packer.extractMeshData(model_path.c_str());
+                if (components.empty()) {
+                    std::cerr << "No mesh data extracted or error loading model." << std::endl;
+                    return 1;
+                }
+                std::cout << "\nStream pass " << pass + 1 << "/" << passes << "." << std::endl;
+            }
+
+            // Rate control: order + transform the whole scene, then pick per-plane thresholds for it
+            if (byte_budget > 0 || max_error > 0.0f) {
+                settings.source_hashes = prepareScene(components, settings, jobs, session_state);
+                settings.delta_max_error = max_error;
+                settings.plane_thresholds = byte_budget > 0
+                    ? RateControl::allocateBudget(components, levels, coefficient_bits, byte_budget, settings.delta_max_error)
+                    : RateControl::allocateError(components, levels, coefficient_bits, max_error);
+            }
+
+            if (jobs > 1) {
+                // Pipelined: worker pool compresses, dedicated sender thread transmits in target_id order
+                std::cout << "Pipelined dispatch: " << jobs << " workers, queue depth " << jobs * 2 << "." << std::endl;
+                TxPipeline pipeline(settings, jobs, (size_t)jobs * 2, session_state);
+                pipeline.run(components, send);
+            } else {
+                ProgressiveDispatcher dispatcher(send);
+                uint32_t current_target_id = 0;
+                for (auto& component : components) {
+                    // 4. Transmit Component (detail bands, if any, are held until their window's base frames are out)
+                    dispatcher.dispatch(packComponent(packer, component, current_target_id++, settings, session_state));
+                }
+                dispatcher.flush();
+            }
         }
 
         std::cout << "\nMission complete. All spatial components dispatched." << std::endl;
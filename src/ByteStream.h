@@ -0,0 +1,80 @@
+#ifndef BYTE_STREAM_H
+#define BYTE_STREAM_H
+
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+
+/**
+ * Varint Aura Check:
+ * Spatial payloads are dominated by small integers (quantized coefficients, zero runs,
+ * index deltas). LEB128 varints spend 1 byte on anything below 128 instead of a fixed 4,
+ * and ZigZag folds signed deltas onto unsigned values so -1 costs as little as +1.
+ * Readers are bounds-checked: a truncated UDP frame must fail cleanly, never over-read.
+ */
+
+inline uint32_t zigzagEncode(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t zigzagDecode(uint32_t v) {
+    return static_cast<int32_t>(v >> 1) ^ -static_cast<int32_t>(v & 1);
+}
+
+inline void writeVarint(std::vector<uint8_t>& out, uint32_t v) {
+    while (v >= 0x80) {
+        out.push_back(static_cast<uint8_t>(v | 0x80));
+        v >>= 7;
+    }
+    out.push_back(static_cast<uint8_t>(v));
+}
+
+inline size_t varintSize(uint32_t v) {
+    size_t size = 1;
+    for (; v >= 0x80; v >>= 7) ++size;
+    return size;
+}
+
+template <typename T>
+inline void writeRaw(std::vector<uint8_t>& out, const T& v) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(&v);
+    out.insert(out.end(), p, p + sizeof(T));
+}
+
+struct ByteReader {
+    const uint8_t* ptr;
+    const uint8_t* end;
+
+    ByteReader(const uint8_t* data, size_t size) : ptr(data), end(data + size) {}
+
+    size_t remaining() const { return static_cast<size_t>(end - ptr); }
+
+    bool readVarint(uint32_t& v) {
+        v = 0;
+        for (int shift = 0; shift < 35; shift += 7) {
+            if (ptr >= end) return false;
+            uint8_t byte = *ptr++;
+            v |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) return true;
+        }
+        return false;
+    }
+
+    template <typename T>
+    bool readRaw(T& v) {
+        if (remaining() < sizeof(T)) return false;
+        std::memcpy(&v, ptr, sizeof(T));
+        ptr += sizeof(T);
+        return true;
+    }
+
+    bool readBytes(std::vector<uint8_t>& out, size_t count) {
+        if (remaining() < count) return false;
+        out.assign(ptr, ptr + count);
+        ptr += count;
+        return true;
+    }
+};
+
+#endif // BYTE_STREAM_H
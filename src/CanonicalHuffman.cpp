@@ -0,0 +1,263 @@
+#include "CanonicalHuffman.h"
+#include <algorithm>
+#include <iostream>
+
+void CanonicalHuffman::buildLengths(const std::array<uint32_t, 256>& counts) {
+    lengths_.fill(0);
+
+    // 1. Collect live symbols, sorted by ascending frequency (ties broken by symbol for determinism)
+    std::array<uint16_t, 256> symbols;
+    int n = 0;
+    for (int s = 0; s < 256; ++s) {
+        if (counts[s]) symbols[n++] = (uint16_t)s;
+    }
+    if (n == 0) return;
+    if (n == 1) {
+        lengths_[symbols[0]] = 1;
+        return;
+    }
+    std::sort(symbols.begin(), symbols.begin() + n, [&](uint16_t a, uint16_t b) {
+        return counts[a] != counts[b] ? counts[a] < counts[b] : a < b;
+    });
+
+    // 2. Two-queue Huffman construction over flat arrays: leaves [0, n), internal nodes [n, 2n-1)
+    std::array<uint64_t, 511> weight;
+    std::array<uint16_t, 511> parent;
+    for (int i = 0; i < n; ++i) weight[i] = counts[symbols[i]];
+
+    int leaf = 0, node = n, next = n;
+    auto pick = [&]() {
+        if (leaf < n && (node >= next || weight[leaf] <= weight[node])) return leaf++;
+        return node++;
+    };
+    while (next < 2 * n - 1) {
+        int a = pick();
+        int b = pick();
+        weight[next] = weight[a] + weight[b];
+        parent[a] = parent[b] = (uint16_t)next;
+        ++next;
+    }
+
+    // Parents are always created after their children, so one reverse sweep yields every depth
+    std::array<uint8_t, 511> depth;
+    depth[2 * n - 2] = 0;
+    std::array<int, 256> num_codes{};
+    for (int i = 2 * n - 3; i >= 0; --i) {
+        depth[i] = depth[parent[i]] + 1;
+        if (i < n) num_codes[depth[i]]++;
+    }
+
+    // 3. Length-limit to kMaxCodeLength and repair the Kraft sum
+    for (int len = kMaxCodeLength + 1; len < 256; ++len) {
+        num_codes[kMaxCodeLength] += num_codes[len];
+        num_codes[len] = 0;
+    }
+    uint32_t total = 0;
+    for (int len = 1; len <= kMaxCodeLength; ++len) {
+        total += (uint32_t)num_codes[len] << (kMaxCodeLength - len);
+    }
+    while (total != (1u << kMaxCodeLength)) {
+        num_codes[kMaxCodeLength]--;
+        for (int len = kMaxCodeLength - 1; len > 0; --len) {
+            if (num_codes[len]) {
+                num_codes[len]--;
+                num_codes[len + 1] += 2;
+                break;
+            }
+        }
+        total--;
+    }
+
+    // 4. Rarest symbols take the longest codes
+    int idx = 0;
+    for (int len = kMaxCodeLength; len > 0; --len) {
+        for (int k = 0; k < num_codes[len]; ++k) {
+            lengths_[symbols[idx++]] = (uint8_t)len;
+        }
+    }
+}
+
+bool CanonicalHuffman::buildCodes() {
+    std::array<uint16_t, kMaxCodeLength + 1> bl_count{};
+    for (uint8_t len : lengths_) {
+        if (len > kMaxCodeLength) return false;
+        bl_count[len]++;
+    }
+    bl_count[0] = 0;
+
+    // Reject oversubscribed length sets (corrupt or hostile headers)
+    int32_t left = 1;
+    for (int len = 1; len <= kMaxCodeLength; ++len) {
+        left = (left << 1) - bl_count[len];
+        if (left < 0) return false;
+    }
+
+    std::array<uint16_t, kMaxCodeLength + 2> next_code{};
+    uint16_t code = 0;
+    for (int len = 1; len <= kMaxCodeLength; ++len) {
+        code = (uint16_t)((code + bl_count[len - 1]) << 1);
+        next_code[len] = code;
+    }
+    for (int s = 0; s < 256; ++s) {
+        if (lengths_[s]) codes_[s] = next_code[lengths_[s]]++;
+    }
+    return true;
+}
+
+bool CanonicalHuffman::buildDecodeTable() {
+    const uint32_t primary_size = 1u << kPrimaryBits;
+    std::fill(table_.begin(), table_.begin() + primary_size, DecodeEntry{0, 0, 0});
+
+    // 1. Short codes fill every primary slot they prefix
+    std::array<uint8_t, 1u << kPrimaryBits> prefix_max{};
+    for (int s = 0; s < 256; ++s) {
+        const int len = lengths_[s];
+        if (len == 0) continue;
+        if (len <= kPrimaryBits) {
+            const uint32_t base = (uint32_t)codes_[s] << (kPrimaryBits - len);
+            const uint32_t span = 1u << (kPrimaryBits - len);
+            for (uint32_t k = 0; k < span; ++k) {
+                table_[base + k] = DecodeEntry{(uint16_t)s, (uint8_t)len, 0};
+            }
+        } else {
+            uint8_t& m = prefix_max[codes_[s] >> (len - kPrimaryBits)];
+            m = std::max(m, (uint8_t)len);
+        }
+    }
+
+    // 2. Long codes share a second-level table per 11-bit prefix
+    uint32_t offset = primary_size;
+    for (uint32_t p = 0; p < primary_size; ++p) {
+        if (!prefix_max[p]) continue;
+        const uint8_t sub_bits = (uint8_t)(prefix_max[p] - kPrimaryBits);
+        if (offset + (1u << sub_bits) > kTableSize) return false;
+        table_[p] = DecodeEntry{(uint16_t)offset, 0, sub_bits};
+        std::fill(table_.begin() + offset, table_.begin() + offset + (1u << sub_bits), DecodeEntry{0, 0, 0});
+        offset += 1u << sub_bits;
+    }
+    for (int s = 0; s < 256; ++s) {
+        const int len = lengths_[s];
+        if (len <= kPrimaryBits) continue;
+        const DecodeEntry& root = table_[codes_[s] >> (len - kPrimaryBits)];
+        const int tail_bits = len - kPrimaryBits;
+        const uint32_t tail = codes_[s] & ((1u << tail_bits) - 1);
+        const uint32_t base = root.value + (tail << (root.sub_bits - tail_bits));
+        const uint32_t span = 1u << (root.sub_bits - tail_bits);
+        for (uint32_t k = 0; k < span; ++k) {
+            table_[base + k] = DecodeEntry{(uint16_t)s, (uint8_t)len, 0};
+        }
+    }
+    return true;
+}
+
+std::vector<uint8_t> CanonicalHuffman::compress(const std::vector<uint8_t>& input) {
+    std::array<uint32_t, 256> counts{};
+    for (uint8_t b : input) counts[b]++;
+
+    buildLengths(counts);
+    buildCodes();
+
+    uint64_t total_bits = 0;
+    for (int s = 0; s < 256; ++s) total_bits += (uint64_t)counts[s] * lengths_[s];
+
+    const size_t header_size = 1 + sizeof(uint32_t) + (input.empty() ? 0 : 128);
+    std::vector<uint8_t> output(header_size + (size_t)((total_bits + 7) / 8));
+    uint8_t* out = output.data();
+
+    // 1. Header: version, symbol count, nibble-packed lengths
+    const uint32_t count = (uint32_t)input.size();
+    *out++ = kVersion;
+    for (int k = 0; k < 4; ++k) *out++ = (uint8_t)(count >> (8 * k));
+    if (input.empty()) return output;
+    for (int s = 0; s < 256; s += 2) {
+        *out++ = (uint8_t)(lengths_[s] | (lengths_[s + 1] << 4));
+    }
+
+    // 2. Bitstream: codes are appended at the bottom of a 64-bit accumulator, flushed 32 bits at a time
+    uint64_t acc = 0;
+    int nbits = 0;
+    for (uint8_t b : input) {
+        acc = (acc << lengths_[b]) | codes_[b];
+        nbits += lengths_[b];
+        if (nbits >= 32) {
+            nbits -= 32;
+            const uint32_t word = (uint32_t)(acc >> nbits);
+            out[0] = (uint8_t)(word >> 24);
+            out[1] = (uint8_t)(word >> 16);
+            out[2] = (uint8_t)(word >> 8);
+            out[3] = (uint8_t)word;
+            out += 4;
+        }
+    }
+    while (nbits >= 8) {
+        nbits -= 8;
+        *out++ = (uint8_t)(acc >> nbits);
+    }
+    if (nbits > 0) *out++ = (uint8_t)(acc << (8 - nbits));
+
+    return output;
+}
+
+std::vector<uint8_t> CanonicalHuffman::decompress(const std::vector<uint8_t>& input) {
+    if (input.size() < 1 + sizeof(uint32_t) || input[0] != kVersion) {
+        std::cerr << "[Huffman] Unsupported stream version." << std::endl;
+        return {};
+    }
+    uint32_t count = 0;
+    for (int k = 0; k < 4; ++k) count |= (uint32_t)input[1 + k] << (8 * k);
+    if (count == 0) return {};
+
+    const uint8_t* ptr = input.data() + 1 + sizeof(uint32_t);
+    const uint8_t* end = input.data() + input.size();
+    if (end - ptr < 128) {
+        std::cerr << "[Huffman] Truncated code length table." << std::endl;
+        return {};
+    }
+    for (int s = 0; s < 256; s += 2) {
+        lengths_[s] = *ptr & 0x0F;
+        lengths_[s + 1] = *ptr >> 4;
+        ++ptr;
+    }
+    if (!buildCodes() || !buildDecodeTable()) {
+        std::cerr << "[Huffman] Invalid code length table." << std::endl;
+        return {};
+    }
+
+    // Each output byte costs at least one bit, which bounds the allocation for hostile counts
+    const uint64_t available_bits = (uint64_t)(end - ptr) * 8;
+    if (count > available_bits) {
+        std::cerr << "[Huffman] Truncated bitstream." << std::endl;
+        return {};
+    }
+
+    std::vector<uint8_t> output(count);
+    uint64_t bitbuf = 0;
+    int bitcount = 0;
+    uint64_t consumed = 0;
+    for (uint32_t i = 0; i < count; ++i) {
+        if (bitcount < kMaxCodeLength) {
+            while (bitcount <= 56) {
+                const uint64_t byte = ptr < end ? *ptr++ : 0;
+                bitbuf |= byte << (56 - bitcount);
+                bitcount += 8;
+            }
+        }
+        DecodeEntry e = table_[bitbuf >> (64 - kPrimaryBits)];
+        if (e.sub_bits) {
+            e = table_[e.value + ((bitbuf << kPrimaryBits) >> (64 - e.sub_bits))];
+        }
+        if (e.length == 0) {
+            std::cerr << "[Huffman] Corrupt bitstream." << std::endl;
+            return {};
+        }
+        output[i] = (uint8_t)e.value;
+        bitbuf <<= e.length;
+        bitcount -= e.length;
+        consumed += e.length;
+    }
+    if (consumed > available_bits) {
+        std::cerr << "[Huffman] Truncated bitstream." << std::endl;
+        return {};
+    }
+    return output;
+}
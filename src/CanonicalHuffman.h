@@ -0,0 +1,54 @@
+#ifndef CANONICAL_HUFFMAN_H
+#define CANONICAL_HUFFMAN_H
+
+#include <vector>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Canonical Huffman Aura Check:
+ * The Librarian in quasar_core builds a shared_ptr tree per call and encodes through a
+ * std::map<uchar, std::string>, so every symbol costs a map lookup plus string appends and
+ * every decoded bit costs a pointer chase. This codec keeps the same compress/decompress
+ * signatures but transmits only code lengths (canonical form), so both sides derive codes
+ * from fixed arrays:
+ * - Encode: O(1) symbol -> (code, length) table, 64-bit accumulator flushed 32 bits at a time.
+ * - Decode: 11-bit first-level lookup resolves every code up to 11 bits in one probe; longer
+ *   codes (capped at 15 bits) take one extra probe into a second-level table.
+ *
+ * Wire format (version 2):
+ *   [u8 version][u32 symbol_count][128 B nibble-packed code lengths][MSB-first bitstream]
+ */
+
+class CanonicalHuffman {
+public:
+    static constexpr uint8_t kVersion = 2;
+    static constexpr int kMaxCodeLength = 15;
+    static constexpr int kPrimaryBits = 11;
+
+    std::vector<uint8_t> compress(const std::vector<uint8_t>& input);
+    std::vector<uint8_t> decompress(const std::vector<uint8_t>& input);
+
+private:
+    struct DecodeEntry {
+        uint16_t value;   // Symbol, or second-level table offset when sub_bits != 0
+        uint8_t length;   // Full code length; 0 marks an unused slot
+        uint8_t sub_bits; // Width of the second-level index
+    };
+
+    // Worst case: 256 overflow prefixes, each with a 2^(15-11) second-level table
+    static constexpr size_t kTableSize = (1u << kPrimaryBits) + 256 * (1u << (kMaxCodeLength - kPrimaryBits));
+
+    void buildLengths(const std::array<uint32_t, 256>& counts);
+    bool buildCodes();
+    bool buildDecodeTable();
+
+    std::array<uint8_t, 256> lengths_{};
+    std::array<uint16_t, 256> codes_{};
+    // Left uninitialized: ~24 KB that compress() never reads, and buildDecodeTable() clears the
+    // primary table and each second-level table it hands out before decompress() probes them
+    std::array<DecodeEntry, kTableSize> table_;
+};
+
+#endif // CANONICAL_HUFFMAN_H
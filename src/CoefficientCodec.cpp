@@ -0,0 +1,129 @@
+#include "CoefficientCodec.h"
+#include "ByteStream.h"
+#include "CanonicalHuffman.h"
+#include "../lib/quasar_core/huffman.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+void CoefficientCodec::planeSteps(const float* coefficients, size_t count, int bits, float steps[3]) {
+    bits = std::clamp(bits, 2, 24);
+    const float q_max = (float)((1 << (bits - 1)) - 1);
+    steps[0] = steps[1] = steps[2] = 0.0f;
+    for (size_t i = 0; i < count / 3 * 3; ++i) {
+        steps[i % 3] = std::max(steps[i % 3], std::abs(coefficients[i]));
+    }
+    for (int c = 0; c < 3; ++c) steps[c] /= q_max;
+}
+
+void CoefficientCodec::encodeSignificance(const float* coefficients, size_t count, const float steps[3], std::vector<uint8_t>& body,
+                                          size_t& zero_count) {
+    const uint32_t num_vertices = (uint32_t)(count / 3);
+    body.reserve(body.size() + num_vertices);
+    zero_count = 0;
+    for (int c = 0; c < 3; ++c) {
+        const float inv_step = steps[c] > 0.0f ? 1.0f / steps[c] : 0.0f;
+        uint32_t run = 0;
+        for (uint32_t i = 0; i < num_vertices; ++i) {
+            int32_t q = (int32_t)std::lround(coefficients[(size_t)i * 3 + c] * inv_step);
+            if (q == 0) {
+                ++run;
+                ++zero_count;
+                continue;
+            }
+            writeVarint(body, run);
+            writeVarint(body, zigzagEncode(q));
+            run = 0;
+        }
+        if (run > 0) writeVarint(body, run);
+    }
+}
+
+bool CoefficientCodec::decodeSignificance(const uint8_t* body, size_t size, uint32_t num_vertices, const float steps[3],
+                                          std::vector<float>& coefficients) {
+    coefficients.assign((size_t)num_vertices * 3, 0.0f);
+    ByteReader body_reader(body, size);
+    for (int c = 0; c < 3; ++c) {
+        uint32_t i = 0;
+        while (i < num_vertices) {
+            uint32_t run = 0, zz = 0;
+            if (!body_reader.readVarint(run) || run > num_vertices - i) return false;
+            i += run;
+            if (i == num_vertices) break;
+            if (!body_reader.readVarint(zz)) return false;
+            coefficients[(size_t)i * 3 + c] = (float)zigzagDecode(zz) * steps[c];
+            ++i;
+        }
+    }
+    return true;
+}
+
+void CoefficientCodec::roundTrip(const float* coefficients, size_t count, const float steps[3], float* out) {
+    float inv_steps[3];
+    for (int c = 0; c < 3; ++c) inv_steps[c] = steps[c] > 0.0f ? 1.0f / steps[c] : 0.0f;
+    for (size_t i = 0; i < count / 3 * 3; ++i) {
+        const int c = (int)(i % 3);
+        out[i] = (float)(int32_t)std::lround(coefficients[i] * inv_steps[c]) * steps[c];
+    }
+}
+
+std::vector<uint8_t> CoefficientCodec::encode(const float* coefficients, size_t count, int bits, int levels) {
+    bits = std::clamp(bits, 2, 24);
+    const uint32_t num_vertices = (uint32_t)(count / 3);
+
+    // 1. Per-plane quantization step
+    float steps[3];
+    planeSteps(coefficients, count, bits, steps);
+
+    // 2. Significance coding: (zero_run, zigzag(q)) pairs per plane
+    std::vector<uint8_t> body;
+    size_t zero_count = 0;
+    encodeSignificance(coefficients, count, steps, body, zero_count);
+
+    // 3. Entropy stage
+    CanonicalHuffman librarian;
+    std::vector<uint8_t> entropy = librarian.compress(body);
+
+    std::vector<uint8_t> stream;
+    stream.reserve(3 + sizeof(uint32_t) + sizeof(steps) + entropy.size());
+    stream.push_back(kVersion);
+    stream.push_back((uint8_t)bits);
+    stream.push_back((uint8_t)levels);
+    writeRaw(stream, num_vertices);
+    for (float step : steps) writeRaw(stream, step);
+    stream.insert(stream.end(), entropy.begin(), entropy.end());
+
+    std::cout << "[Spatial] Coefficient stream: " << count * sizeof(float) << " -> "
+              << stream.size() << " bytes (" << bits << "-bit, "
+              << (num_vertices ? 100 * zero_count / ((size_t)num_vertices * 3) : 0) << "% zero)." << std::endl;
+    return stream;
+}
+
+bool CoefficientCodec::decode(const std::vector<uint8_t>& stream, std::vector<float>& coefficients, int& levels, size_t max_vertices) {
+    ByteReader reader(stream.data(), stream.size());
+
+    uint8_t version = 0, bits = 0, depth = 1;
+    uint32_t num_vertices = 0;
+    float steps[3];
+    if (!reader.readRaw(version) || version < 1 || version > kVersion) return false;
+    if (!reader.readRaw(bits)) return false;
+    if (version >= 3 && !reader.readRaw(depth)) return false;
+    if (!reader.readRaw(num_vertices) || num_vertices > max_vertices) return false;
+    levels = depth;
+    for (float& step : steps) {
+        if (!reader.readRaw(step)) return false;
+    }
+
+    // Version 1 streams were entropy-coded by the quasar_core Librarian
+    std::vector<uint8_t> entropy(reader.ptr, reader.end);
+    std::vector<uint8_t> body;
+    if (version == 1) {
+        HuffmanCodec legacy;
+        body = legacy.decompress(entropy);
+    } else {
+        CanonicalHuffman librarian;
+        body = librarian.decompress(entropy);
+    }
+
+    return decodeSignificance(body.data(), body.size(), num_vertices, steps, coefficients);
+}
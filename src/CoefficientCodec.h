@@ -0,0 +1,56 @@
+#ifndef COEFFICIENT_CODEC_H
+#define COEFFICIENT_CODEC_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Coefficient Bitstream Aura Check:
+ * After compressMesh the interleaved buffer holds Haar coefficients, most of which the
+ * saliency threshold has zeroed. Shipping them as raw floats wastes that sparsity, so the
+ * stream is built in three stages:
+ * 1. Quantization: each plane (X, Y, Z) gets its own uniform step = max|c| / (2^(bits-1) - 1),
+ *    so a flat axis does not inherit the precision budget of a tall one.
+ * 2. Significance coding: every plane becomes (zero_run, zigzag(q)) varint pairs, so a run of
+ *    thresholded coefficients collapses to a single byte.
+ * 3. Entropy coding: the varint body goes through CanonicalHuffman (version 2; version 1
+ *    streams used the quasar_core Librarian and are still decoded).
+ *
+ * Layout: [u8 version][u8 bits][u8 levels][u32 vertex_count][f32 step X/Y/Z][Huffman(body)]
+ * (versions 1-2 carry no levels byte and imply a single-level transform)
+ */
+
+class CoefficientCodec {
+public:
+    static constexpr uint8_t kVersion = 3;
+    static constexpr int kDefaultBits = 14;
+
+    // Quantizes interleaved xyz coefficients and emits the sparse, entropy-coded stream;
+    // `levels` records the transform depth the receiver must invert
+    static std::vector<uint8_t> encode(const float* coefficients, size_t count, int bits, int levels);
+    static std::vector<uint8_t> encode(const std::vector<float>& coefficients, int bits, int levels) {
+        return encode(coefficients.data(), coefficients.size(), bits, levels);
+    }
+
+    // Per-plane quantization steps encode() will use: max|c| / (2^(bits-1) - 1)
+    static void planeSteps(const float* coefficients, size_t count, int bits, float steps[3]);
+
+    // Restores interleaved xyz coefficients and their transform depth; returns false on a
+    // malformed or truncated stream. Zero runs let a few bytes describe any vertex count, so
+    // streams claiming more than max_vertices are rejected before anything is allocated.
+    static bool decode(const std::vector<uint8_t>& stream, std::vector<float>& coefficients, int& levels, size_t max_vertices);
+
+    // Stage 2 on its own, for containers that carry the vertex count, depth and steps themselves
+    // (SpatialFrame): appends the varint body to `body`
+    static void encodeSignificance(const float* coefficients, size_t count, const float steps[3], std::vector<uint8_t>& body,
+                                   size_t& zero_count);
+    static bool decodeSignificance(const uint8_t* body, size_t size, uint32_t num_vertices, const float steps[3],
+                                   std::vector<float>& coefficients);
+
+    // The coefficients a receiver will decode for `steps`, without building a stream; `out` may
+    // alias `coefficients`
+    static void roundTrip(const float* coefficients, size_t count, const float steps[3], float* out);
+};
+
+#endif // COEFFICIENT_CODEC_H
@@ -0,0 +1,148 @@
+#include "FrameDecoder.h"
+#include "CoefficientCodec.h"
+#include "HaarTransform.h"
+#include "IndexCodec.h"
+#include "SpatialFrame.h"
+#include "TxPipeline.h"
+#include "../lib/quasar_core/quasar_format.h"
+#include <algorithm>
+#include <cstring>
+
+std::string FrameDecoder::exportStem(uint32_t target_id) {
+    return "recovered_mesh_" + std::to_string(target_id);
+}
+
+void FrameDecoder::handle(const std::vector<uint8_t>& frame_raw) {
+    if (frame_raw.size() < sizeof(QuasarHeader)) return;
+
+    const QuasarHeader* header = reinterpret_cast<const QuasarHeader*>(frame_raw.data());
+    if (std::string(header->magic, 4) != "QSR1") return;
+
+    if (header->file_type == kFileTypeDetailBand) {
+        // Progressive refinement: merge the band and re-export the sharper model
+        const uint8_t* payload_ptr = frame_raw.data() + sizeof(QuasarHeader);
+        size_t payload_size = frame_raw.size() - sizeof(QuasarHeader);
+        if (!refiner_.refine(header->target_id, header->width, payload_ptr, payload_size)) {
+            std::cerr << "[Receiver] Unmatched or malformed detail band, dropping frame." << std::endl;
+            return;
+        }
+
+        MeshData refined;
+        refiner_.reconstruct(header->target_id, packer_, refined);
+        std::cout << "[Receiver] Target " << header->target_id << " refined: "
+                  << refiner_.bandsReceived(header->target_id) << "/" << refiner_.bandCount(header->target_id)
+                  << " bands." << std::endl;
+        SpatialPacker::saveMesh(exportStem(header->target_id), format_, refined);
+    } else if (header->file_type == kFileTypeSpatialDelta) {
+        // Temporal delta: residual onto the cached keyframe state, topology reused
+        const uint8_t* payload_ptr = frame_raw.data() + sizeof(QuasarHeader);
+        size_t payload_size = frame_raw.size() - sizeof(QuasarHeader);
+        if (!deltas_.apply(header->target_id, header->width, payload_ptr, payload_size)) {
+            std::cerr << "[Receiver] Delta for target " << header->target_id << " out of sync, waiting for keyframe." << std::endl;
+            return;
+        }
+
+        MeshData updated;
+        deltas_.reconstruct(header->target_id, packer_, updated);
+        std::cout << "[Receiver] Delta applied to target " << header->target_id << " (" << payload_size << " bytes)." << std::endl;
+        SpatialPacker::saveMesh(exportStem(header->target_id), format_, updated);
+    } else if (header->file_type == kFileTypeSpatial) {
+        std::cout << "\n[Receiver] Incoming Spatial Frame (Target: " << header->target_id << ")" << std::endl;
+
+        const uint8_t* payload_ptr = frame_raw.data() + sizeof(QuasarHeader);
+        size_t payload_size = frame_raw.size() - sizeof(QuasarHeader);
+        const bool progressive = header->compression_flags & kFlagProgressive;
+        // original_size counts at least 12 bytes per vertex: nothing larger is allocated
+        const size_t max_vertices = header->original_size / (3 * sizeof(float));
+
+        // 1-2. Coefficients, topology and attributes
+        MeshData recovered;
+        size_t float_count = header->width;
+        int levels = 1;
+        uint32_t epoch = 0;
+        if (header->compression_flags & kFlagSectioned) {
+            if (!SpatialFrame::decode(payload_ptr, payload_size, max_vertices, progressive, recovered, float_count, levels, epoch)) {
+                std::cerr << "[Receiver] Malformed sectioned payload, dropping frame." << std::endl;
+                return;
+            }
+        } else if (!decodeLegacy(header->compression_flags, float_count, max_vertices, payload_ptr, payload_size, recovered, levels)) {
+            return;
+        }
+
+        // 3. Decompress Vertices (Inverse Wavelet)
+        if (progressive) {
+            // Coarse model now; detail band frames refine it in place
+            if (!refiner_.begin(header->target_id, float_count, levels, std::move(recovered))) return;
+            refiner_.reconstruct(header->target_id, packer_, recovered);
+            std::cout << "[Receiver] Coarse model ready: 1/" << refiner_.bandCount(header->target_id) << " bands." << std::endl;
+            SpatialPacker::saveMesh(exportStem(header->target_id), format_, recovered);
+            return;
+        }
+        if (header->compression_flags & kFlagSessionKeyframe) {
+            // Later delta frames for this target apply to these coefficients
+            deltas_.keyframe(header->target_id, levels, epoch, recovered);
+        }
+        packer_.decompressMesh(recovered.vertices, levels);
+
+        // 4. Export (OBJ, GLB or blob)
+        SpatialPacker::saveMesh(exportStem(header->target_id), format_, recovered);
+    }
+}
+
+bool FrameDecoder::decodeLegacy(uint8_t flags, size_t float_count, size_t max_vertices, const uint8_t* payload_ptr, size_t payload_size,
+                                MeshData& mesh, int& levels) {
+    // 1. Separate Payload
+    size_t vertex_bytes = 0;
+    if (flags & 0x04) {
+        // Quantized coefficient stream: [u32 size][stream]
+        uint32_t stream_size = 0;
+        if (payload_size < sizeof(uint32_t)) return false;
+        std::memcpy(&stream_size, payload_ptr, sizeof(uint32_t));
+        vertex_bytes = sizeof(uint32_t) + stream_size;
+        if (payload_size < vertex_bytes) return false;
+
+        // A progressive base frame carries only the approximation band
+        std::vector<uint8_t> coefficient_stream(payload_ptr + sizeof(uint32_t), payload_ptr + vertex_bytes);
+        if (!CoefficientCodec::decode(coefficient_stream, mesh.vertices, levels, std::min(max_vertices, float_count / 3)) ||
+            mesh.vertices.size() != ((flags & kFlagProgressive) ? haarBandSizes(float_count / 3, levels)[0] * 3 : float_count)) {
+            std::cerr << "[Receiver] Malformed coefficient stream, dropping frame." << std::endl;
+            return false;
+        }
+    } else {
+        // Legacy raw float payload
+        vertex_bytes = float_count * sizeof(float);
+        if (payload_size < vertex_bytes) return false;
+        mesh.vertices.resize(float_count);
+        std::memcpy(mesh.vertices.data(), payload_ptr, vertex_bytes);
+    }
+
+    // Extract Topology stream
+    size_t topology_bytes = payload_size - vertex_bytes;
+    std::vector<uint8_t> topology_stream(payload_ptr + vertex_bytes, payload_ptr + vertex_bytes + topology_bytes);
+
+    // 2. Decompress Indices
+    std::cout << "[Receiver] Decompressing topology..." << std::endl;
+    if (flags & 0x10) {
+        if (!IndexCodec::decode(topology_stream, mesh.indices)) {
+            std::cerr << "[Receiver] Malformed topology stream, dropping frame." << std::endl;
+            return false;
+        }
+    } else {
+        // Legacy byte-wise Huffman over raw uint32 indices
+        std::vector<uint8_t> index_raw = (flags & 0x08)
+            ? librarian_.decompress(topology_stream)
+            : legacy_librarian_.decompress(topology_stream);
+        mesh.indices.resize(index_raw.size() / sizeof(uint32_t));
+        std::memcpy(mesh.indices.data(), index_raw.data(), mesh.indices.size() * sizeof(uint32_t));
+    }
+
+    // 3. Every index must name a vertex of this frame before it reaches an exporter
+    const size_t vertex_count = float_count / 3;
+    for (uint32_t idx : mesh.indices) {
+        if (idx >= vertex_count) {
+            std::cerr << "[Receiver] Topology references vertex " << idx << " of " << vertex_count << ", dropping frame." << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
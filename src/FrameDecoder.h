@@ -0,0 +1,45 @@
+#ifndef FRAME_DECODER_H
+#define FRAME_DECODER_H
+
+#include <vector>
+#include <cstdint>
+#include <string>
+#include "SpatialPacker.h"
+#include "CanonicalHuffman.h"
+#include "ProgressiveReceiver.h"
+#include "TemporalDelta.h"
+#include "../lib/quasar_core/huffman.h"
+
+/**
+ * Frame Decoder Aura Check:
+ * Everything the receiver does with one reassembled frame: header validation, sectioned (or
+ * legacy) payload decode, inverse wavelet (or progressive refinement / temporal delta) and export. A
+ * decoder owns its packer scratch, Huffman tables and progressive and delta sessions, so RxPipeline gives each worker
+ * its own instance and routes every target_id to the same worker; no state is shared.
+ */
+
+class FrameDecoder {
+public:
+    explicit FrameDecoder(ExportFormat format = ExportFormat::OBJ) : format_(format) {}
+
+    // Decodes one complete frame (QuasarHeader + payload) and exports the recovered mesh.
+    // Malformed frames are logged and dropped.
+    void handle(const std::vector<uint8_t>& frame_raw);
+
+private:
+    static std::string exportStem(uint32_t target_id);
+
+    // Pre-sectioned base frame: [u32 size][coefficient stream][topology stream], float count from
+    // QuasarHeader::width
+    bool decodeLegacy(uint8_t flags, size_t float_count, size_t max_vertices, const uint8_t* payload, size_t size, MeshData& mesh,
+                      int& levels);
+
+    ExportFormat format_;
+    SpatialPacker packer_;
+    CanonicalHuffman librarian_;
+    HuffmanCodec legacy_librarian_;
+    ProgressiveReceiver refiner_;
+    DeltaReceiver deltas_;
+};
+
+#endif // FRAME_DECODER_H
@@ -0,0 +1,195 @@
+#include "HaarTransform.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define QUASAR_HAS_AVX2_KERNELS 1
+#endif
+
+namespace {
+
+// Pairs [begin, end): approximations in place, details into `detail`
+void forwardPairsScalar(float* xyz, float* detail, size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+        const float* a = xyz + i * 6;
+        float avg[3], diff[3];
+        for (int c = 0; c < 3; ++c) {
+            avg[c] = (a[c] + a[c + 3]) * 0.5f;
+            diff[c] = a[c] - a[c + 3];
+        }
+        std::memcpy(xyz + i * 3, avg, sizeof(avg));
+        std::memcpy(detail + i * 3, diff, sizeof(diff));
+    }
+}
+
+// Pairs (begin, end] walked downwards so outputs never overwrite unread approximations
+void inversePairsScalar(float* xyz, const float* detail, size_t begin, size_t end) {
+    for (size_t i = end; i-- > begin;) {
+        float a[3], b[3];
+        for (int c = 0; c < 3; ++c) {
+            const float avg = xyz[i * 3 + c];
+            const float half = detail[i * 3 + c] * 0.5f;
+            a[c] = avg + half;
+            b[c] = avg - half;
+        }
+        std::memcpy(xyz + i * 6, a, sizeof(a));
+        std::memcpy(xyz + i * 6 + 3, b, sizeof(b));
+    }
+}
+
+size_t forwardPairsScalarAll(float* xyz, float* detail, size_t pairs, size_t /*count*/) {
+    forwardPairsScalar(xyz, detail, 0, pairs);
+    return pairs;
+}
+
+size_t inversePairsScalarAll(float* xyz, const float* detail, size_t pairs) {
+    inversePairsScalar(xyz, detail, 0, pairs);
+    return pairs;
+}
+
+#ifdef QUASAR_HAS_AVX2_KERNELS
+// Packs lanes of `lo` selected by lo_idx and lanes of `hi` selected by hi_idx under `mask`
+__attribute__((target("avx2"))) inline __m256 gather2(__m256 lo, __m256 hi, __m256i lo_idx, __m256i hi_idx, int mask_bits) {
+    const __m256 a = _mm256_permutevar8x32_ps(lo, lo_idx);
+    const __m256 b = _mm256_permutevar8x32_ps(hi, hi_idx);
+    const __m256i mask = _mm256_setr_epi32(mask_bits & 1 ? -1 : 0, mask_bits & 2 ? -1 : 0, mask_bits & 4 ? -1 : 0,
+                                           mask_bits & 8 ? -1 : 0, mask_bits & 16 ? -1 : 0, mask_bits & 32 ? -1 : 0,
+                                           mask_bits & 64 ? -1 : 0, mask_bits & 128 ? -1 : 0);
+    return _mm256_blendv_ps(a, b, _mm256_castsi256_ps(mask));
+}
+
+// Four pairs (24 floats) per iteration. Pair k of a block lives at floats [6k, 6k + 6); adding
+// the stream to itself shifted by 3 puts a + b in lanes where (offset mod 6) < 3, which are then
+// compacted into 12 contiguous outputs.
+__attribute__((target("avx2"))) void compact12(__m256 s0, __m256 s1, __m256 s2, float* out) {
+    const __m256 first = gather2(s0, s1, _mm256_setr_epi32(0, 1, 2, 6, 7, 0, 0, 0),
+                                 _mm256_setr_epi32(0, 0, 0, 0, 0, 0, 4, 5), 0xE0);
+    const __m256 second = gather2(s1, s2, _mm256_setr_epi32(6, 0, 0, 0, 0, 0, 0, 0),
+                                  _mm256_setr_epi32(0, 2, 3, 4, 0, 0, 0, 0), 0x0E);
+    _mm256_storeu_ps(out, first);
+    _mm_storeu_ps(out + 8, _mm256_castps256_ps128(second));
+}
+
+__attribute__((target("avx2"))) size_t forwardPairsAVX2(float* xyz, float* detail, size_t pairs, size_t count) {
+    const __m256 half = _mm256_set1_ps(0.5f);
+    size_t i = 0;
+    // The shifted loads read 3 floats past the block, so the last block must not touch the end
+    for (; i + 4 <= pairs && (i + 4) * 6 + 3 <= count * 3; i += 4) {
+        const float* p = xyz + i * 6;
+        const __m256 a0 = _mm256_loadu_ps(p), a1 = _mm256_loadu_ps(p + 8), a2 = _mm256_loadu_ps(p + 16);
+        const __m256 b0 = _mm256_loadu_ps(p + 3), b1 = _mm256_loadu_ps(p + 11), b2 = _mm256_loadu_ps(p + 19);
+        compact12(_mm256_sub_ps(a0, b0), _mm256_sub_ps(a1, b1), _mm256_sub_ps(a2, b2), detail + i * 3);
+        compact12(_mm256_mul_ps(_mm256_add_ps(a0, b0), half), _mm256_mul_ps(_mm256_add_ps(a1, b1), half),
+                  _mm256_mul_ps(_mm256_add_ps(a2, b2), half), xyz + i * 3);
+    }
+    forwardPairsScalar(xyz, detail, i, pairs);
+    return pairs;
+}
+
+__attribute__((target("avx2"))) size_t inversePairsAVX2(float* xyz, const float* detail, size_t pairs) {
+    const size_t blocks = pairs / 4;
+    inversePairsScalar(xyz, detail, blocks * 4, pairs);
+
+    const __m256 half = _mm256_set1_ps(0.5f);
+    for (size_t k = blocks; k-- > 0;) {
+        const size_t i = k * 4;
+        const float* avg = xyz + i * 3;
+        const float* diff = detail + i * 3;
+        const __m256 avg_lo = _mm256_loadu_ps(avg), avg_hi = _mm256_loadu_ps(avg + 4);
+        const __m256 half_lo = _mm256_mul_ps(_mm256_loadu_ps(diff), half);
+        const __m256 half_hi = _mm256_mul_ps(_mm256_loadu_ps(diff + 4), half);
+        const __m256 a_lo = _mm256_add_ps(avg_lo, half_lo), a_hi = _mm256_add_ps(avg_hi, half_hi); // A[0..7], A[4..11]
+        const __m256 b_lo = _mm256_sub_ps(avg_lo, half_lo), b_hi = _mm256_sub_ps(avg_hi, half_hi); // B[0..7], B[4..11]
+
+        // Re-interleave [a0 b0 a1 b1 a2 b2 a3 b3] (xyz each) from the two 12-float streams
+        const __m256 out0 = gather2(a_lo, b_lo, _mm256_setr_epi32(0, 1, 2, 0, 0, 0, 3, 4),
+                                    _mm256_setr_epi32(0, 0, 0, 0, 1, 2, 0, 0), 0x38);
+        const __m256 out1 = gather2(a_hi, b_lo, _mm256_setr_epi32(1, 0, 0, 0, 2, 3, 4, 0),
+                                    _mm256_setr_epi32(0, 3, 4, 5, 0, 0, 0, 6), 0x8E);
+        const __m256 out2 = gather2(b_hi, a_hi, _mm256_setr_epi32(3, 4, 0, 0, 0, 5, 6, 7),
+                                    _mm256_setr_epi32(0, 0, 5, 6, 7, 0, 0, 0), 0x1C);
+        float* out = xyz + i * 6;
+        _mm256_storeu_ps(out, out0);
+        _mm256_storeu_ps(out + 8, out1);
+        _mm256_storeu_ps(out + 16, out2);
+    }
+    return pairs;
+}
+#endif
+
+using ForwardKernel = size_t (*)(float*, float*, size_t, size_t);
+using InverseKernel = size_t (*)(float*, const float*, size_t);
+
+struct HaarKernels {
+    ForwardKernel forward = forwardPairsScalarAll;
+    InverseKernel inverse = inversePairsScalarAll;
+
+    HaarKernels() {
+#ifdef QUASAR_HAS_AVX2_KERNELS
+        if (__builtin_cpu_supports("avx2")) {
+            forward = forwardPairsAVX2;
+            inverse = inversePairsAVX2;
+        }
+#endif
+    }
+};
+
+const HaarKernels& kernels() {
+    static const HaarKernels resolved;
+    return resolved;
+}
+
+} // namespace
+
+std::vector<size_t> haarBandSizes(size_t count, int levels) {
+    std::vector<size_t> details;
+    size_t m = count;
+    for (int l = 0; l < std::min(levels, kMaxHaarLevels) && m >= 2; ++l) {
+        details.push_back(m / 2);
+        m -= m / 2;
+    }
+    std::vector<size_t> bands{m};
+    bands.insert(bands.end(), details.rbegin(), details.rend());
+    return bands;
+}
+
+void haarForwardInterleaved(float* xyz, size_t count, int levels, std::vector<float>& scratch) {
+    const HaarKernels& k = kernels();
+    if (scratch.size() < (count / 2) * 3) scratch.resize((count / 2) * 3);
+
+    size_t m = count;
+    for (int l = 0; l < std::min(levels, kMaxHaarLevels) && m >= 2; ++l) {
+        const size_t pairs = m / 2;
+        const size_t approx = m - pairs;
+
+        // 1. Approximations compact into the front, details into scratch
+        k.forward(xyz, scratch.data(), pairs, m);
+        // 2. Odd tail vertex joins the approximation band
+        if (m & 1) std::memmove(xyz + pairs * 3, xyz + (m - 1) * 3, 3 * sizeof(float));
+        // 3. Details land behind the approximations
+        std::memcpy(xyz + approx * 3, scratch.data(), pairs * 3 * sizeof(float));
+        m = approx;
+    }
+}
+
+void haarInverseInterleaved(float* xyz, size_t count, int levels, std::vector<float>& scratch) {
+    const HaarKernels& k = kernels();
+    if (scratch.size() < (count / 2) * 3) scratch.resize((count / 2) * 3);
+
+    // Replay the forward level sizes from the coarsest level outwards
+    std::vector<size_t> sizes;
+    for (size_t m = count; (int)sizes.size() < std::min(levels, kMaxHaarLevels) && m >= 2; m -= m / 2) {
+        sizes.push_back(m);
+    }
+
+    for (auto it = sizes.rbegin(); it != sizes.rend(); ++it) {
+        const size_t m = *it;
+        const size_t pairs = m / 2;
+        const size_t approx = m - pairs;
+
+        std::memcpy(scratch.data(), xyz + approx * 3, pairs * 3 * sizeof(float));
+        if (m & 1) std::memmove(xyz + (m - 1) * 3, xyz + pairs * 3, 3 * sizeof(float));
+        k.inverse(xyz, scratch.data(), pairs);
+    }
+}
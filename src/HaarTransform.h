@@ -0,0 +1,35 @@
+#ifndef HAAR_TRANSFORM_H
+#define HAAR_TRANSFORM_H
+
+#include <vector>
+#include <cstddef>
+
+/**
+ * Interleaved Haar Aura Check:
+ * The planar path de-interleaved xyz into three temporary vectors, ran haar1D on each (which
+ * allocates its own temporary again), then re-interleaved. These kernels transform the xyz
+ * buffer directly: a vertex pair (a, b) becomes avg = (a + b) / 2 and detail = a - b per axis,
+ * which is coefficient-for-coefficient what the planar path produced.
+ * - Approximations are written back in place (slot i never overtakes pair 2i being read);
+ *   details go to caller-owned scratch and are copied behind them, so one level costs a single
+ *   pass plus a half-length copy and no allocation once scratch is warm.
+ * - An odd sample count carries the last vertex into the approximation band instead of
+ *   dropping it.
+ * - Multi-level: each level re-runs on the approximation band. Level l of n vertices leaves
+ *   [approx | detail_L | ... | detail_1] with band sizes given by haarBandSizes().
+ * - AVX2 kernels process four vertex pairs per iteration and are selected at runtime via
+ *   __builtin_cpu_supports; the scalar kernels handle tails and non-AVX2 hosts.
+ */
+
+constexpr int kMaxHaarLevels = 16;
+
+// Forward transform of count interleaved xyz samples, up to `levels` levels
+void haarForwardInterleaved(float* xyz, size_t count, int levels, std::vector<float>& scratch);
+
+// Inverse of haarForwardInterleaved with the same count and levels
+void haarInverseInterleaved(float* xyz, size_t count, int levels, std::vector<float>& scratch);
+
+// Band sizes in vertices, coarsest first: [approx, detail_L, ..., detail_1]
+std::vector<size_t> haarBandSizes(size_t count, int levels);
+
+#endif // HAAR_TRANSFORM_H
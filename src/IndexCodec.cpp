@@ -0,0 +1,167 @@
+#include "IndexCodec.h"
+#include "ByteStream.h"
+#include "CanonicalHuffman.h"
+#include <algorithm>
+#include <iostream>
+
+std::vector<uint8_t> IndexCodec::encodeDelta(const std::vector<uint32_t>& indices) {
+    std::vector<uint8_t> body;
+    body.reserve(indices.size() + indices.size() / 2);
+    uint32_t next_new = 0;
+    for (uint32_t idx : indices) {
+        writeVarint(body, zigzagEncode((int32_t)(idx - next_new)));
+        if (idx >= next_new) next_new = idx + 1;
+    }
+    return body;
+}
+
+std::vector<uint8_t> IndexCodec::encodeEdge(const std::vector<uint32_t>& indices, std::vector<uint32_t>& coded) {
+    const size_t tri_count = indices.size() / 3;
+    std::vector<uint8_t> body(tri_count);
+    body.reserve(tri_count + indices.size());
+
+    // Rotated triangles as the decoder will see them; the window looks back into this
+    coded.resize(indices.size());
+    uint32_t next_new = 0;
+    auto emit = [&](uint32_t idx) {
+        writeVarint(body, zigzagEncode((int32_t)(idx - next_new)));
+        if (idx >= next_new) next_new = idx + 1;
+    };
+
+    for (size_t t = 0; t < tri_count; ++t) {
+        const uint32_t* cur = &indices[t * 3];
+        uint32_t* tri = &coded[t * 3];
+        std::copy(cur, cur + 3, tri);
+        uint8_t op = kOpExplicit;
+
+        // Look for a recent edge (u, v) that this triangle walks as (v, u)
+        const size_t window_size = std::min<size_t>(t, kEdgeWindow);
+        for (size_t slot = 0; slot < window_size && op == kOpExplicit; ++slot) {
+            const uint32_t* ref = &coded[(t - 1 - slot) * 3];
+            for (int e = 0; e < 3 && op == kOpExplicit; ++e) {
+                const uint32_t u = ref[e], v = ref[(e + 1) % 3];
+                for (int r = 0; r < 3; ++r) {
+                    if (cur[r] == v && cur[(r + 1) % 3] == u) {
+                        tri[0] = v;
+                        tri[1] = u;
+                        tri[2] = cur[(r + 2) % 3];
+                        op = (uint8_t)(slot * 3 + e);
+                        break;
+                    }
+                }
+            }
+        }
+
+        body[t] = op;
+        if (op == kOpExplicit) {
+            emit(tri[0]);
+            emit(tri[1]);
+        }
+        emit(tri[2]);
+    }
+    return body;
+}
+
+uint8_t IndexCodec::encodeBody(const std::vector<uint32_t>& indices, std::vector<uint32_t>& rotated, std::vector<uint8_t>& best) {
+    CanonicalHuffman librarian;
+    best = librarian.compress(encodeDelta(indices));
+    if (indices.empty() || indices.size() % 3 != 0) return kModeDelta;
+
+    std::vector<uint8_t> edge = librarian.compress(encodeEdge(indices, rotated));
+    if (edge.size() >= best.size()) return kModeDelta;
+    best.swap(edge);
+    return kModeEdge;
+}
+
+size_t IndexCodec::encodedSize(const std::vector<uint32_t>& indices) {
+    std::vector<uint32_t> rotated;
+    std::vector<uint8_t> best;
+    encodeBody(indices, rotated, best);
+    return kHeaderBytes + best.size();
+}
+
+std::vector<uint8_t> IndexCodec::encode(std::vector<uint32_t>& indices) {
+    std::vector<uint32_t> rotated;
+    std::vector<uint8_t> best;
+    const uint8_t mode = encodeBody(indices, rotated, best);
+    if (mode == kModeEdge) indices.swap(rotated);
+
+    std::vector<uint8_t> stream;
+    stream.reserve(kHeaderBytes + best.size());
+    stream.push_back(kVersion);
+    stream.push_back(mode);
+    writeRaw(stream, (uint32_t)indices.size());
+    stream.insert(stream.end(), best.begin(), best.end());
+
+    std::cout << "[Spatial] Topology stream: " << indices.size() * sizeof(uint32_t) << " -> " << stream.size()
+              << " bytes (" << (mode == kModeEdge ? "edge" : "delta") << " mode)." << std::endl;
+    return stream;
+}
+
+bool IndexCodec::decodeDelta(const std::vector<uint8_t>& body, std::vector<uint32_t>& indices) {
+    ByteReader reader(body.data(), body.size());
+    uint32_t next_new = 0;
+    for (uint32_t& idx : indices) {
+        uint32_t zz = 0;
+        if (!reader.readVarint(zz)) return false;
+        idx = next_new + (uint32_t)zigzagDecode(zz);
+        if (idx >= next_new) next_new = idx + 1;
+    }
+    return true;
+}
+
+bool IndexCodec::decodeEdge(const std::vector<uint8_t>& body, std::vector<uint32_t>& indices) {
+    const size_t tri_count = indices.size() / 3;
+    if (body.size() < tri_count) return false;
+    ByteReader reader(body.data() + tri_count, body.size() - tri_count);
+
+    uint32_t next_new = 0;
+    auto next = [&](uint32_t& idx) {
+        uint32_t zz = 0;
+        if (!reader.readVarint(zz)) return false;
+        idx = next_new + (uint32_t)zigzagDecode(zz);
+        if (idx >= next_new) next_new = idx + 1;
+        return true;
+    };
+
+    for (size_t t = 0; t < tri_count; ++t) {
+        const uint8_t op = body[t];
+        uint32_t* tri = &indices[t * 3];
+        if (op == kOpExplicit) {
+            if (!next(tri[0]) || !next(tri[1])) return false;
+        } else {
+            const size_t slot = op / 3;
+            const int e = op % 3;
+            if (op > kOpExplicit || slot >= std::min<size_t>(t, kEdgeWindow)) return false;
+            // The window is the previous kEdgeWindow triangles in the output itself
+            const uint32_t* ref = &indices[(t - 1 - slot) * 3];
+            tri[0] = ref[(e + 1) % 3];
+            tri[1] = ref[e];
+        }
+        if (!next(tri[2])) return false;
+    }
+    return true;
+}
+
+bool IndexCodec::decode(const std::vector<uint8_t>& stream, std::vector<uint32_t>& indices) {
+    ByteReader reader(stream.data(), stream.size());
+    uint8_t version = 0, mode = 0;
+    uint32_t count = 0;
+    if (!reader.readRaw(version) || version != kVersion) return false;
+    if (!reader.readRaw(mode) || !reader.readRaw(count)) return false;
+
+    CanonicalHuffman librarian;
+    std::vector<uint8_t> body = librarian.decompress(std::vector<uint8_t>(reader.ptr, reader.end));
+
+    // Every index (delta) or triangle (op + new vertex) costs body bytes, which bounds the
+    // allocation for hostile counts
+    if (mode == kModeDelta && count <= body.size()) {
+        indices.assign(count, 0);
+        return decodeDelta(body, indices);
+    }
+    if (mode == kModeEdge && count % 3 == 0 && (size_t)count / 3 * 2 <= body.size()) {
+        indices.assign(count, 0);
+        return decodeEdge(body, indices);
+    }
+    return false;
+}
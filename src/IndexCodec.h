@@ -0,0 +1,56 @@
+#ifndef INDEX_CODEC_H
+#define INDEX_CODEC_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+/**
+ * Topology Coding Aura Check:
+ * Byte-wise Huffman over raw uint32 indices sees four mostly-unrelated byte streams and none
+ * of the mesh structure. This codec works on whole indices instead:
+ * - Indices are predicted from the high-water mark: after SpatialPacker::optimizeTopology
+ *   renumbers vertices in first-use order, a fresh vertex is always hwm + 1 (delta 0) and a
+ *   revisit is a small negative delta, both coded as zigzag varints.
+ * - Delta mode: every index is coded that way.
+ * - Edge mode (triangle lists only): a triangle that shares an edge with one of the last
+ *   kEdgeWindow triangles is coded as an edge op plus its third vertex, strip-style. The
+ *   triangle is rotated so the shared edge comes first, which keeps its winding intact.
+ * Both bodies are entropy-coded and the smaller one is sent. encode() applies the same
+ * rotation to the caller's list, so TX and RX hold identical index vectors.
+ *
+ * Layout: [u8 version][u8 mode][u32 index_count][CanonicalHuffman(body)]
+ * Edge body: [u8 op per triangle][varint deltas], op = 3 * window_slot + edge, or kOpExplicit.
+ */
+
+class IndexCodec {
+public:
+    static constexpr uint8_t kVersion = 1;
+    static constexpr uint8_t kModeDelta = 0;
+    static constexpr uint8_t kModeEdge = 1;
+
+    // Codes the index list with whichever mode yields the smaller stream; edge mode rotates
+    // triangles in place to match what decode() will produce
+    static std::vector<uint8_t> encode(std::vector<uint32_t>& indices);
+
+    // Byte size encode() would return, without touching `indices` or logging (rate-control probes)
+    static size_t encodedSize(const std::vector<uint32_t>& indices);
+
+    // Restores the index list; returns false on a malformed or truncated stream
+    static bool decode(const std::vector<uint8_t>& stream, std::vector<uint32_t>& indices);
+
+private:
+    static constexpr size_t kEdgeWindow = 8;
+    static constexpr uint8_t kOpExplicit = 3 * kEdgeWindow;
+
+    static constexpr size_t kHeaderBytes = 2 + sizeof(uint32_t);
+
+    // Entropy-coded body of the smaller mode; `rotated` holds the edge-mode indices when chosen
+    static uint8_t encodeBody(const std::vector<uint32_t>& indices, std::vector<uint32_t>& rotated, std::vector<uint8_t>& best);
+    static std::vector<uint8_t> encodeDelta(const std::vector<uint32_t>& indices);
+    static std::vector<uint8_t> encodeEdge(const std::vector<uint32_t>& indices, std::vector<uint32_t>& coded);
+    static bool decodeDelta(const std::vector<uint8_t>& body, std::vector<uint32_t>& indices);
+    static bool decodeEdge(const std::vector<uint8_t>& body, std::vector<uint32_t>& indices);
+};
+
+#endif // INDEX_CODEC_H
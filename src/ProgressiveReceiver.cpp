@@ -0,0 +1,66 @@
+#include "ProgressiveReceiver.h"
+#include "CoefficientCodec.h"
+#include "HaarTransform.h"
+#include <algorithm>
+
+bool ProgressiveReceiver::begin(uint32_t target_id, size_t float_count, int levels, MeshData&& base) {
+    const std::vector<size_t> bands = haarBandSizes(float_count / 3, levels);
+    if (float_count % 3 != 0 || base.vertices.size() != bands[0] * 3) {
+        std::cerr << "[Receiver] Base frame does not match its band layout." << std::endl;
+        return false;
+    }
+
+    // 1. Band layout replayed from the vertex count and depth, exactly as the TX split it
+    Session session;
+    session.levels = levels;
+    session.band_offsets.push_back(0);
+    for (size_t band : bands) session.band_offsets.push_back(session.band_offsets.back() + band);
+    session.received.assign(bands.size(), false);
+    session.received[0] = true;
+
+    // 2. Approximation band in front, details zero until they arrive
+    session.mesh = std::move(base);
+    session.mesh.vertices.resize(float_count, 0.0f);
+
+    sessions_[target_id] = std::move(session);
+    return true;
+}
+
+bool ProgressiveReceiver::refine(uint32_t target_id, size_t float_count, const uint8_t* payload, size_t size) {
+    auto it = sessions_.find(target_id);
+    if (it == sessions_.end() || it->second.mesh.vertices.size() != float_count || size < 1) return false;
+    Session& session = it->second;
+
+    const size_t band = payload[0];
+    if (band == 0 || band >= session.received.size()) return false;
+
+    std::vector<uint8_t> stream(payload + 1, payload + size);
+    std::vector<float> coefficients;
+    int levels = 0;
+    const size_t first = session.band_offsets[band];
+    const size_t count = session.band_offsets[band + 1] - first;
+    if (!CoefficientCodec::decode(stream, coefficients, levels, count) || coefficients.size() != count * 3) return false;
+
+    std::copy(coefficients.begin(), coefficients.end(), session.mesh.vertices.begin() + first * 3);
+    session.received[band] = true;
+    return true;
+}
+
+bool ProgressiveReceiver::reconstruct(uint32_t target_id, SpatialPacker& packer, MeshData& mesh) const {
+    auto it = sessions_.find(target_id);
+    if (it == sessions_.end()) return false;
+
+    mesh = it->second.mesh;
+    packer.decompressMesh(mesh.vertices, it->second.levels);
+    return true;
+}
+
+size_t ProgressiveReceiver::bandsReceived(uint32_t target_id) const {
+    auto it = sessions_.find(target_id);
+    return it == sessions_.end() ? 0 : (size_t)std::count(it->second.received.begin(), it->second.received.end(), true);
+}
+
+size_t ProgressiveReceiver::bandCount(uint32_t target_id) const {
+    auto it = sessions_.find(target_id);
+    return it == sessions_.end() ? 0 : it->second.received.size();
+}
@@ -0,0 +1,49 @@
+#ifndef PROGRESSIVE_RECEIVER_H
+#define PROGRESSIVE_RECEIVER_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include "SpatialPacker.h"
+
+/**
+ * Progressive Refinement Aura Check:
+ * A progressive component arrives as a base frame (approximation band + topology) followed by
+ * one frame per detail band. The receiver keeps the full coefficient buffer per target_id with
+ * every band it has not seen yet left at zero, which an inverse Haar turns into the coarser
+ * level's geometry. So every base or band frame yields a complete, valid mesh; refinement just
+ * fills in the missing details. Bands can arrive in any order or not at all (a lost band only
+ * costs detail), and a band without a matching base frame is ignored.
+ */
+
+class ProgressiveReceiver {
+public:
+    // Starts (or restarts) a target from its base frame. base.vertices holds the decoded
+    // approximation band (topology and attributes ride along); float_count and levels describe
+    // the full transform
+    bool begin(uint32_t target_id, size_t float_count, int levels, MeshData&& base);
+
+    // Decodes a detail band frame payload ([u8 band][coefficient stream]) into the target's buffer.
+    // Returns false if no matching base frame was received or the payload is malformed
+    bool refine(uint32_t target_id, size_t float_count, const uint8_t* payload, size_t size);
+
+    // Inverse-transforms the current coefficients into `mesh`; returns false for unknown targets
+    bool reconstruct(uint32_t target_id, SpatialPacker& packer, MeshData& mesh) const;
+
+    // Number of bands received / expected (approximation included)
+    size_t bandsReceived(uint32_t target_id) const;
+    size_t bandCount(uint32_t target_id) const;
+
+private:
+    struct Session {
+        int levels = 1;
+        std::vector<size_t> band_offsets; // First vertex of each band, plus the total at the end
+        std::vector<bool> received;
+        MeshData mesh; // vertices hold coefficients
+    };
+
+    std::map<uint32_t, Session> sessions_;
+};
+
+#endif // PROGRESSIVE_RECEIVER_H
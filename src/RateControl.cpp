@@ -0,0 +1,185 @@
+#include "RateControl.h"
+#include "CoefficientCodec.h"
+#include "HaarTransform.h"
+#include "SpatialFrame.h"
+#include "../lib/quasar_core/quasar_format.h"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+RateControl::Component RateControl::analyze(const std::vector<float>& coefficients, int levels, int bits) {
+    Component component;
+    component.coefficients = &coefficients;
+    CoefficientCodec::planeSteps(coefficients.data(), coefficients.size(), bits, component.steps);
+    for (size_t i = 0; i < coefficients.size() / 3 * 3; ++i) {
+        component.peak[i % 3] = std::max(component.peak[i % 3], std::abs(coefficients[i]));
+    }
+
+    std::vector<float> scratch;
+    component.reference = coefficients;
+    haarInverseInterleaved(component.reference.data(), component.reference.size() / 3, levels, scratch);
+    return component;
+}
+
+float RateControl::candidate(const Component& component, int plane, int k) {
+    if (k >= kStepsPerOctave * kOctaves) return 0.0f;
+    return component.peak[plane] * std::exp2(-(float)k / kStepsPerOctave);
+}
+
+void RateControl::probe(const Component& component, int levels, const PlaneThresholds& thresholds, std::vector<float>& trial,
+                        std::vector<float>& scratch, float error[3]) {
+    const std::vector<float>& coefficients = *component.coefficients;
+    const size_t count = coefficients.size() / 3 * 3;
+
+    // 1. Threshold and quantize exactly as packComponent + SpatialFrame will
+    trial.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        trial[i] = std::abs(coefficients[i]) < thresholds[i % 3] ? 0.0f : coefficients[i];
+    }
+    CoefficientCodec::roundTrip(trial.data(), count, component.steps, trial.data());
+
+    // 2. Decode and compare against the unthresholded geometry
+    haarInverseInterleaved(trial.data(), count / 3, levels, scratch);
+    error[0] = error[1] = error[2] = 0.0f;
+    for (size_t i = 0; i < count; ++i) {
+        error[i % 3] = std::max(error[i % 3], std::abs(trial[i] - component.reference[i]));
+    }
+}
+
+PlaneThresholds RateControl::search(const Component& component, int levels, float max_error, std::vector<float>& trial,
+                                    std::vector<float>& scratch, float error[3]) {
+    // Binary search per plane over candidate indices; index `last` (threshold 0) is the fallback
+    const int last = kStepsPerOctave * kOctaves;
+    int lo[3] = {0, 0, 0};
+    int hi[3] = {last, last, last};
+    PlaneThresholds thresholds;
+    while (lo[0] < hi[0] || lo[1] < hi[1] || lo[2] < hi[2]) {
+        int mid[3];
+        for (int c = 0; c < 3; ++c) {
+            mid[c] = lo[c] < hi[c] ? (lo[c] + hi[c]) / 2 : hi[c];
+            thresholds[c] = candidate(component, c, mid[c]);
+        }
+        probe(component, levels, thresholds, trial, scratch, error);
+        for (int c = 0; c < 3; ++c) {
+            if (lo[c] >= hi[c]) continue;
+            if (error[c] <= max_error) {
+                hi[c] = mid[c];
+            } else {
+                lo[c] = mid[c] + 1;
+            }
+        }
+    }
+
+    for (int c = 0; c < 3; ++c) thresholds[c] = candidate(component, c, hi[c]);
+    probe(component, levels, thresholds, trial, scratch, error);
+    return thresholds;
+}
+
+std::vector<PlaneThresholds> RateControl::allocateError(const std::vector<MeshData>& components, int levels, int bits, float max_error) {
+    std::vector<PlaneThresholds> thresholds(components.size(), PlaneThresholds{0.0f, 0.0f, 0.0f});
+    std::vector<float> trial, scratch;
+    float worst = 0.0f;
+
+    for (size_t i = 0; i < components.size(); ++i) {
+        if (components[i].vertices.empty()) continue;
+        const Component component = analyze(components[i].vertices, levels, bits);
+        float error[3];
+        thresholds[i] = search(component, levels, max_error, trial, scratch, error);
+        worst = std::max({worst, error[0], error[1], error[2]});
+        if (error[0] > max_error || error[1] > max_error || error[2] > max_error) {
+            std::cerr << "[Spatial] Component [" << i << "]: quantization alone exceeds --max-error "
+                      << max_error << " (reached " << std::max({error[0], error[1], error[2]}) << "); raise --bits." << std::endl;
+        }
+    }
+
+    std::cout << "[Spatial] Rate control: max error " << max_error << " -> per-plane thresholds for "
+              << components.size() << " component(s), worst decoded error " << worst << "." << std::endl;
+    return thresholds;
+}
+
+PlaneThresholds RateControl::allocateResidual(const std::vector<float>& residual, int levels, int bits, float max_error) {
+    std::vector<float> trial, scratch;
+    const Component component = analyze(residual, levels, bits);
+    float error[3];
+    return search(component, levels, max_error, trial, scratch, error);
+}
+
+std::vector<PlaneThresholds> RateControl::allocateBudget(const std::vector<MeshData>& components, int levels, int bits, size_t byte_budget,
+                                                         float& error_bound) {
+    // 1. Per-component analysis; the topology stream and framing do not depend on thresholds
+    std::vector<Component> analyzed(components.size());
+    float scene_peak = 0.0f;
+    for (size_t i = 0; i < components.size(); ++i) {
+        analyzed[i] = analyze(components[i].vertices, levels, bits);
+        const MeshData& mesh = components[i];
+        std::vector<uint8_t> sections(1, SpatialFrame::kVersion);
+        SpatialFrame::appendLayout(sections, mesh, levels);
+        SpatialFrame::appendAttributes(sections, mesh);
+        analyzed[i].fixed_bytes = sizeof(QuasarHeader) + sections.size() + SpatialFrame::topologyBytes(mesh.indices, mesh.vertices.size() / 3);
+        scene_peak = std::max({scene_peak, analyzed[i].peak[0], analyzed[i].peak[1], analyzed[i].peak[2]});
+    }
+
+    // 2. Estimated pass size for one scene-wide error bound
+    std::vector<float> trial, scratch, thresholded;
+    std::vector<uint8_t> positions;
+    float worst = 0.0f;
+    auto passBytes = [&](float bound, std::vector<PlaneThresholds>& thresholds) {
+        thresholds.assign(components.size(), PlaneThresholds{0.0f, 0.0f, 0.0f});
+        size_t total = 0;
+        worst = 0.0f;
+        for (size_t i = 0; i < analyzed.size(); ++i) {
+            const Component& component = analyzed[i];
+            total += component.fixed_bytes;
+            if (component.coefficients->empty()) continue;
+
+            float error[3];
+            thresholds[i] = search(component, levels, bound, trial, scratch, error);
+            worst = std::max({worst, error[0], error[1], error[2]});
+            thresholded = *component.coefficients;
+            SpatialPacker::applyThresholds(thresholded, thresholds[i]);
+            positions.clear();
+            SpatialFrame::appendPositions(positions, thresholded.data(), thresholded.size(), bits);
+            total += positions.size();
+        }
+        return total;
+    };
+
+    // 3. Geometric bisection for the smallest bound that fits
+    std::vector<PlaneThresholds> best, probe_thresholds;
+    float best_error = 0.0f;
+    float hi = std::max(scene_peak, 1e-6f) * 2.0f;
+    float lo = hi * std::exp2(-(float)kOctaves);
+    size_t best_bytes = passBytes(hi, best);
+    best_error = worst;
+    error_bound = hi;
+    if (best_bytes > byte_budget) {
+        std::cerr << "[Spatial] Rate control: budget " << byte_budget << " bytes does not fit; estimated pass at the coarsest bound is "
+                  << best_bytes << " bytes, sending that." << std::endl;
+        return best;
+    }
+    size_t bytes = passBytes(lo, probe_thresholds);
+    if (bytes <= byte_budget) {
+        best = probe_thresholds;
+        best_bytes = bytes;
+        best_error = worst;
+        hi = lo;
+        error_bound = lo;
+    }
+    for (int iteration = 0; iteration < kBudgetIterations && lo < hi; ++iteration) {
+        const float mid = std::sqrt(lo * hi);
+        bytes = passBytes(mid, probe_thresholds);
+        if (bytes <= byte_budget) {
+            hi = mid;
+            error_bound = mid;
+            best.swap(probe_thresholds);
+            best_bytes = bytes;
+            best_error = worst;
+        } else {
+            lo = mid;
+        }
+    }
+
+    std::cout << "[Spatial] Rate control: budget " << byte_budget << " bytes -> worst decoded error " << best_error
+              << ", estimated pass " << best_bytes << " bytes." << std::endl;
+    return best;
+}
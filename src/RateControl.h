@@ -0,0 +1,77 @@
+#ifndef RATE_CONTROL_H
+#define RATE_CONTROL_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "SpatialPacker.h"
+
+/**
+ * Rate Control Aura Check:
+ * --threshold is one absolute value for every coefficient plane of every component, so it
+ * zeroes all of a small part's detail while barely touching a large one, and the pass size is
+ * whatever falls out. With --max-error or --bitrate the scene is ordered and transformed first
+ * (prepareComponent), then thresholds are picked per component and per plane:
+ * - Candidates are log-spaced below the plane's peak magnitude (kStepsPerOctave per octave,
+ *   kOctaves deep, then 0), i.e. the edges of a magnitude histogram.
+ * - Error mode: per plane, binary search for the largest candidate whose decoded coordinates
+ *   stay within max_error of the unthresholded geometry. Each probe thresholds, quantizes with
+ *   the same steps CoefficientCodec will use and runs the inverse Haar, so the bound covers
+ *   quantization too. The three planes are independent and are searched in the same probes.
+ * - Budget mode: one scene-wide error bound is bisected (geometrically) until the estimated
+ *   pass size fits the budget; every component then gets the thresholds for that bound, which
+ *   spends bytes where the geometry needs them. The estimate builds the real positions section
+ *   and adds the header plus the layout, topology and attribute sections, i.e. a single-frame
+ *   keyframe; progressive bands add a few bytes each and session deltas come in well under it.
+ * - Session deltas: the absolute thresholds can sit near a plane's peak, far above typical
+ *   motion, so they are never reused as the residual dead zone. allocateResidual runs the same
+ *   search on the residual against the receiver's cache; the transform is linear, so the decoded
+ *   error against the current coefficients is the residual's own round-trip error and the delta
+ *   honours the same bound (max_error, or the bound budget mode settled on).
+ * Thresholds travel to packComponent through TxSettings::plane_thresholds, the bound through
+ * TxSettings::delta_max_error.
+ */
+
+class RateControl {
+public:
+    static constexpr int kStepsPerOctave = 8;
+    static constexpr int kOctaves = 24;
+    static constexpr int kBudgetIterations = 16;
+
+    // Per-component thresholds keeping every decoded coordinate within max_error. Components
+    // must already be ordered and transformed (prepareComponent).
+    static std::vector<PlaneThresholds> allocateError(const std::vector<MeshData>& components, int levels, int bits, float max_error);
+
+    // Per-component thresholds for the smallest scene-wide error bound whose pass fits
+    // byte_budget; falls back to the coarsest bound (with a warning) when nothing fits.
+    // error_bound receives the bound that was picked.
+    static std::vector<PlaneThresholds> allocateBudget(const std::vector<MeshData>& components, int levels, int bits, size_t byte_budget,
+                                                       float& error_bound);
+
+    // Dead zone for a session delta: thresholds on `residual` (current minus cached coefficients)
+    // keeping the decoded coordinates within max_error of the current geometry
+    static PlaneThresholds allocateResidual(const std::vector<float>& residual, int levels, int bits, float max_error);
+
+private:
+    struct Component {
+        const std::vector<float>* coefficients = nullptr;
+        std::vector<float> reference; // Inverse of the unthresholded coefficients
+        float steps[3] = {0.0f, 0.0f, 0.0f};
+        float peak[3] = {0.0f, 0.0f, 0.0f};
+        size_t fixed_bytes = 0;       // Header plus every section but positions
+    };
+
+    static Component analyze(const std::vector<float>& coefficients, int levels, int bits);
+    static float candidate(const Component& component, int plane, int k);
+
+    // Largest candidate per plane whose decoded error stays within max_error; `error` receives
+    // the per-plane error actually reached
+    static PlaneThresholds search(const Component& component, int levels, float max_error, std::vector<float>& trial,
+                                  std::vector<float>& scratch, float error[3]);
+
+    // Thresholds + quantizes into `trial`, inverse-transforms it, and returns the per-plane max error
+    static void probe(const Component& component, int levels, const PlaneThresholds& thresholds, std::vector<float>& trial,
+                      std::vector<float>& scratch, float error[3]);
+};
+
+#endif // RATE_CONTROL_H
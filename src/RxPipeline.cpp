@@ -0,0 +1,205 @@
+#include "RxPipeline.h"
+#include "FrameDecoder.h"
+#include "SpscRing.h"
+#include "../lib/quasar_core/quasar_format.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+ReassemblyTable::ReassemblyTable(size_t capacity) {
+    size_t size = 16;
+    while (size < capacity) size <<= 1;
+    slots_.resize(size);
+    mask_ = size - 1;
+}
+
+size_t ReassemblyTable::findOrInsert(uint32_t frame_id) {
+    if ((count_ + 1) * 2 > slots_.size()) grow();
+
+    size_t slot = home(frame_id);
+    while (slots_[slot].used) {
+        if (slots_[slot].frame_id == frame_id) return slot;
+        slot = (slot + 1) & mask_;
+    }
+    slots_[slot].used = true;
+    slots_[slot].frame_id = frame_id;
+    ++count_;
+    return slot;
+}
+
+void ReassemblyTable::erase(size_t slot) {
+    slots_[slot] = Partial();
+    --count_;
+
+    // Pull later entries of the probe run back so no lookup ever stops at the hole
+    for (size_t next = (slot + 1) & mask_; slots_[next].used; next = (next + 1) & mask_) {
+        const size_t ideal = home(slots_[next].frame_id);
+        if (((next - ideal) & mask_) >= ((next - slot) & mask_)) {
+            slots_[slot] = std::move(slots_[next]);
+            slots_[next] = Partial();
+            slot = next;
+        }
+    }
+}
+
+void ReassemblyTable::grow() {
+    std::vector<Partial> old;
+    old.swap(slots_);
+    slots_.resize(old.size() * 2);
+    mask_ = slots_.size() - 1;
+
+    for (Partial& partial : old) {
+        if (!partial.used) continue;
+        size_t slot = home(partial.frame_id);
+        while (slots_[slot].used) slot = (slot + 1) & mask_;
+        slots_[slot] = std::move(partial);
+    }
+}
+
+bool ReassemblyTable::insert(const QuasarChunk& chunk, size_t size, Clock::time_point now, std::vector<uint8_t>& frame) {
+    if (size < kChunkHeaderSize || chunk.data_size > kChunkPayload || size < kChunkHeaderSize + chunk.data_size) return false;
+    if (chunk.total_chunks == 0 || chunk.chunk_id >= chunk.total_chunks) return false;
+
+    const size_t slot = findOrInsert(chunk.frame_id);
+    Partial& partial = slots_[slot];
+
+    // 1. New frame (or a recycled frame_id with a different shape)
+    if (partial.total != chunk.total_chunks) {
+        partial.total = chunk.total_chunks;
+        partial.received = 0;
+        partial.sizes.assign(partial.total, kMissing);
+        partial.data.clear();
+    }
+    partial.last_seen = now;
+    if (partial.sizes[chunk.chunk_id] != kMissing) return false;
+
+    // 2. Chunk lands in its fixed slot; the buffer only grows as far as chunks have reached
+    const size_t offset = (size_t)chunk.chunk_id * kChunkPayload;
+    if (partial.data.size() < offset + chunk.data_size) partial.data.resize(offset + chunk.data_size);
+    std::memcpy(partial.data.data() + offset, chunk.data, chunk.data_size);
+    partial.sizes[chunk.chunk_id] = chunk.data_size;
+    if (++partial.received < partial.total) return false;
+
+    // 3. Complete: close the gaps left by short chunks, then hand the buffer out
+    size_t length = 0;
+    for (size_t i = 0; i < partial.total; ++i) {
+        if (i * kChunkPayload != length) std::memmove(partial.data.data() + length, partial.data.data() + i * kChunkPayload, partial.sizes[i]);
+        length += partial.sizes[i];
+    }
+    partial.data.resize(length);
+    frame = std::move(partial.data);
+    erase(slot);
+    return true;
+}
+
+size_t ReassemblyTable::evictOlderThan(Clock::time_point deadline) {
+    size_t evicted = 0;
+    for (size_t slot = 0; slot < slots_.size();) {
+        if (slots_[slot].used && slots_[slot].last_seen < deadline) {
+            std::cerr << "[Receiver] Evicting incomplete frame " << slots_[slot].frame_id << " ("
+                      << slots_[slot].received << "/" << slots_[slot].total << " chunks)." << std::endl;
+            erase(slot); // Backward shift may refill this slot, so look at it again
+            ++evicted;
+            continue;
+        }
+        ++slot;
+    }
+    return evicted;
+}
+
+RxPipeline::RxPipeline(int port, int workers, ExportFormat format, size_t ring_depth)
+    : port_(port), workers_(std::max(workers, 1)), format_(format), ring_depth_(std::max<size_t>(ring_depth, 1)) {}
+
+bool RxPipeline::run() {
+    using FrameRing = SpscRing<std::vector<uint8_t>>;
+
+    // 1. Socket: large kernel buffer for bursts, short timeout so eviction runs while idle
+    int sock = socket(AF_INET, SOCK_DGRAM, 0);
+    if (sock < 0) {
+        std::cerr << "[Receiver] Failed to create socket: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    int rcvbuf = 8 << 20;
+    setsockopt(sock, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+    timeval timeout = {0, 100000};
+    setsockopt(sock, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+    addr.sin_port = htons((uint16_t)port_);
+    if (bind(sock, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+        std::cerr << "[Receiver] Failed to bind port " << port_ << ": " << std::strerror(errno) << std::endl;
+        close(sock);
+        return false;
+    }
+
+    // 2. Decode workers, one ring each
+    std::vector<std::unique_ptr<FrameRing>> rings;
+    std::vector<std::thread> workers;
+    for (int w = 0; w < workers_; ++w) rings.push_back(std::make_unique<FrameRing>(ring_depth_));
+    for (int w = 0; w < workers_; ++w) {
+        workers.emplace_back([ring = rings[w].get(), format = format_] {
+            FrameDecoder decoder(format);
+            std::vector<uint8_t> frame;
+            for (int idle = 0;;) {
+                if (ring->tryPop(frame)) {
+                    decoder.handle(frame);
+                    idle = 0;
+                } else if (++idle < 64) {
+                    std::this_thread::yield();
+                } else {
+                    std::this_thread::sleep_for(std::chrono::microseconds(200));
+                }
+            }
+        });
+    }
+    std::cout << "[Receiver] " << workers_ << " decode worker(s), batch " << kRecvBatch << " datagrams." << std::endl;
+
+    // 3. Socket loop: batched receive, reassembly, dispatch by target_id
+    std::vector<QuasarChunk> chunks(kRecvBatch);
+    std::vector<iovec> iovs(kRecvBatch);
+    std::vector<mmsghdr> messages(kRecvBatch);
+    for (int i = 0; i < kRecvBatch; ++i) {
+        iovs[i] = {&chunks[i], sizeof(QuasarChunk)};
+        messages[i] = {};
+        messages[i].msg_hdr.msg_iov = &iovs[i];
+        messages[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    ReassemblyTable table;
+    std::vector<uint8_t> frame;
+    auto next_sweep = ReassemblyTable::Clock::now() + kFrameTimeout / 4;
+    while (true) {
+        const int received = recvmmsg(sock, messages.data(), kRecvBatch, MSG_WAITFORONE, nullptr);
+        if (received < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR) {
+            std::cerr << "[Receiver] recvmmsg failed: " << std::strerror(errno) << std::endl;
+        }
+
+        const auto now = ReassemblyTable::Clock::now();
+        for (int i = 0; i < received; ++i) {
+            if (!table.insert(chunks[i], messages[i].msg_len, now, frame)) continue;
+
+            uint32_t target_id = 0;
+            if (frame.size() >= sizeof(QuasarHeader)) {
+                QuasarHeader header;
+                std::memcpy(&header, frame.data(), sizeof(QuasarHeader));
+                target_id = header.target_id;
+            }
+            FrameRing& ring = *rings[target_id % (uint32_t)workers_];
+            while (!ring.tryPush(std::move(frame))) std::this_thread::yield();
+        }
+
+        if (now >= next_sweep) {
+            table.evictOlderThan(now - kFrameTimeout);
+            next_sweep = now + kFrameTimeout / 4;
+        }
+    }
+}
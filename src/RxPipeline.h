@@ -0,0 +1,96 @@
+#ifndef RX_PIPELINE_H
+#define RX_PIPELINE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <chrono>
+#include "SpatialPacker.h"
+
+/**
+ * Parallel RX Aura Check:
+ * QuasarRx::listen reassembles into a std::map per frame and the caller then decoded and wrote
+ * the OBJ inline, so a large component stopped the socket from being drained and the kernel
+ * dropped chunks. The receiver is now split into two stages:
+ * 1. One socket thread pulls up to kRecvBatch datagrams per recvmmsg call, stitches chunks in a
+ *    flat open-addressing table keyed by frame_id, and evicts frames that stop receiving
+ *    chunks for kFrameTimeout (lost chunks would otherwise pin their buffers forever).
+ * 2. Completed frames go to worker (target_id % workers) through that worker's lock-free SPSC
+ *    ring. Each worker owns a FrameDecoder, so decode, inverse wavelet and export never touch
+ *    the socket thread, and a target's base and band frames stay in order on one worker.
+ * A full ring makes the socket thread wait rather than drop a finished frame; the large
+ * SO_RCVBUF absorbs bursts while it waits.
+ */
+
+#pragma pack(push, 1)
+// One datagram as QuasarTx::send_frame puts it on the wire; only 10 + data_size bytes are sent
+struct QuasarChunk {
+    uint32_t frame_id;
+    uint16_t chunk_id;
+    uint16_t total_chunks;
+    uint16_t data_size;
+    uint8_t data[1400];
+};
+#pragma pack(pop)
+
+constexpr size_t kChunkPayload = sizeof(QuasarChunk::data);
+constexpr size_t kChunkHeaderSize = sizeof(QuasarChunk) - kChunkPayload;
+
+// Flat frame_id -> partial frame map (linear probing, backward-shift deletion)
+class ReassemblyTable {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit ReassemblyTable(size_t capacity = 64);
+
+    // Stores one datagram of `size` bytes; returns true and moves the frame into `frame` once its
+    // last chunk arrives. Malformed or duplicate chunks are ignored.
+    bool insert(const QuasarChunk& chunk, size_t size, Clock::time_point now, std::vector<uint8_t>& frame);
+
+    // Drops partial frames that have not received a chunk since `deadline`; returns the count
+    size_t evictOlderThan(Clock::time_point deadline);
+
+    size_t size() const { return count_; }
+
+private:
+    static constexpr uint16_t kMissing = 0xFFFF;
+
+    struct Partial {
+        bool used = false;
+        uint32_t frame_id = 0;
+        uint16_t total = 0;
+        uint16_t received = 0;
+        Clock::time_point last_seen;
+        std::vector<uint16_t> sizes; // Per-chunk data size, kMissing until it arrives
+        std::vector<uint8_t> data;   // Chunk i lives at i * kChunkPayload until compaction
+    };
+
+    size_t home(uint32_t frame_id) const { return (size_t)(frame_id * 2654435761u) & mask_; }
+    size_t findOrInsert(uint32_t frame_id);
+    void erase(size_t slot);
+    void grow();
+
+    std::vector<Partial> slots_;
+    size_t mask_ = 0;
+    size_t count_ = 0;
+};
+
+class RxPipeline {
+public:
+    static constexpr int kRecvBatch = 64;
+    static constexpr std::chrono::milliseconds kFrameTimeout{2000};
+
+    RxPipeline(int port, int workers, ExportFormat format = ExportFormat::OBJ, size_t ring_depth = 64);
+
+    // Binds the socket and receives until the process exits; returns false if the socket cannot
+    // be set up
+    bool run();
+
+private:
+    int port_;
+    int workers_;
+    ExportFormat format_;
+    size_t ring_depth_;
+};
+
+#endif // RX_PIPELINE_H
@@ -0,0 +1,316 @@
+#include "SpatialFrame.h"
+#include "ByteStream.h"
+#include "CanonicalHuffman.h"
+#include "CoefficientCodec.h"
+#include "HaarTransform.h"
+#include "IndexCodec.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+
+namespace {
+// Below this a CanonicalHuffman stream cannot win: its header and length table alone are this big
+constexpr size_t kEntropyFloor = 1 + sizeof(uint32_t) + 128;
+
+void appendSection(std::vector<uint8_t>& frame, uint8_t id, uint8_t codec, const std::vector<uint8_t>& body, bool try_entropy = true) {
+    std::vector<uint8_t> packed;
+    if (try_entropy && body.size() > kEntropyFloor) {
+        CanonicalHuffman librarian;
+        packed = librarian.compress(body);
+    }
+    const bool entropy = !packed.empty() && packed.size() < body.size();
+    const std::vector<uint8_t>& chosen = entropy ? packed : body;
+
+    frame.push_back(id);
+    writeVarint(frame, (uint32_t)(1 + chosen.size()));
+    frame.push_back(entropy ? (uint8_t)(codec | SpatialFrame::kCodecEntropy) : codec);
+    frame.insert(frame.end(), chosen.begin(), chosen.end());
+}
+
+// Topology section holding the raw indices, 16-bit when every vertex fits
+std::vector<uint8_t> rawTopologySection(const std::vector<uint32_t>& indices, size_t vertex_count) {
+    std::vector<uint8_t> raw;
+    if (vertex_count < 65536) {
+        raw.resize(indices.size() * sizeof(uint16_t));
+        for (size_t i = 0; i < indices.size(); ++i) {
+            const uint16_t idx = (uint16_t)indices[i];
+            std::memcpy(raw.data() + i * sizeof(uint16_t), &idx, sizeof(uint16_t));
+        }
+    } else {
+        raw.resize(indices.size() * sizeof(uint32_t));
+        std::memcpy(raw.data(), indices.data(), raw.size());
+    }
+    std::vector<uint8_t> section;
+    appendSection(section, SpatialFrame::kSectionTopology, SpatialFrame::kCodecRaw, raw);
+    return section;
+}
+
+template <typename T>
+T readAt(const uint8_t* in, size_t i) {
+    T value;
+    std::memcpy(&value, in + i * sizeof(T), sizeof(T));
+    return value;
+}
+
+float signOf(float value) { return value >= 0.0f ? 1.0f : -1.0f; }
+} // namespace
+
+std::vector<uint8_t> SpatialFrame::encode(MeshData& mesh, size_t count, int bits, int levels) {
+    std::vector<uint8_t> frame;
+    frame.push_back(kVersion);
+    appendLayout(frame, mesh, levels);
+
+    size_t mark = frame.size();
+    appendPositions(frame, mesh.vertices.data(), count, bits);
+    const size_t position_bytes = frame.size() - mark;
+
+    mark = frame.size();
+    appendTopology(frame, mesh.indices, mesh.vertices.size() / 3);
+    const size_t topology_bytes = frame.size() - mark;
+
+    mark = frame.size();
+    appendAttributes(frame, mesh);
+    const size_t attribute_bytes = frame.size() - mark;
+
+    std::cout << "[Spatial] Sectioned frame: " << frame.size() << " bytes (positions " << position_bytes << ", topology "
+              << topology_bytes << ", attributes " << attribute_bytes << ")." << std::endl;
+    return frame;
+}
+
+void SpatialFrame::appendLayout(std::vector<uint8_t>& frame, const MeshData& mesh, int levels) {
+    const std::vector<PrimitiveRange> ranges = SpatialPacker::primitiveRanges(mesh);
+    std::vector<uint8_t> body;
+    writeVarint(body, (uint32_t)(mesh.vertices.size() / 3));
+    body.push_back((uint8_t)levels);
+    writeVarint(body, (uint32_t)ranges.size());
+    for (const PrimitiveRange& range : ranges) {
+        writeVarint(body, range.vertex_count);
+        writeVarint(body, range.index_count);
+    }
+    appendSection(frame, kSectionLayout, kCodecRaw, body, false);
+}
+
+void SpatialFrame::appendPositions(std::vector<uint8_t>& frame, const float* coefficients, size_t count, int bits) {
+    bits = std::clamp(bits, 2, 24);
+    float steps[3];
+    CoefficientCodec::planeSteps(coefficients, count, bits, steps);
+
+    std::vector<uint8_t> body;
+    body.push_back((uint8_t)bits);
+    for (float step : steps) writeRaw(body, step);
+    size_t zero_count = 0;
+    CoefficientCodec::encodeSignificance(coefficients, count, steps, body, zero_count);
+    appendSection(frame, kSectionPositions, kCodecSignificance, body);
+}
+
+void SpatialFrame::appendTopology(std::vector<uint8_t>& frame, std::vector<uint32_t>& indices, size_t vertex_count) {
+    // 1. Raw indices, 16-bit when every vertex fits
+    const std::vector<uint8_t> raw_section = rawTopologySection(indices, vertex_count);
+
+    // 2. IndexCodec (already entropy-coded) when it beats that
+    if (indices.size() >= 3) {
+        std::vector<uint32_t> coded = indices;
+        std::vector<uint8_t> stream = IndexCodec::encode(coded);
+        std::vector<uint8_t> coded_section;
+        appendSection(coded_section, kSectionTopology, kCodecIndexCodec, stream, false);
+        if (coded_section.size() < raw_section.size()) {
+            indices.swap(coded);
+            frame.insert(frame.end(), coded_section.begin(), coded_section.end());
+            return;
+        }
+    }
+    frame.insert(frame.end(), raw_section.begin(), raw_section.end());
+}
+
+size_t SpatialFrame::topologyBytes(const std::vector<uint32_t>& indices, size_t vertex_count) {
+    const size_t raw_bytes = rawTopologySection(indices, vertex_count).size();
+    if (indices.size() < 3) return raw_bytes;
+    const size_t stream_bytes = IndexCodec::encodedSize(indices);
+    return std::min(raw_bytes, 2 + varintSize((uint32_t)(1 + stream_bytes)) + stream_bytes);
+}
+
+void SpatialFrame::appendAttributes(std::vector<uint8_t>& frame, const MeshData& mesh) {
+    const size_t vertex_count = mesh.vertices.size() / 3;
+    if (vertex_count == 0) return;
+
+    // Normals: octahedral projection, one int16 plane per component
+    if (mesh.normals.size() == vertex_count * 3) {
+        std::vector<int16_t> octahedral(vertex_count * 2);
+        for (size_t v = 0; v < vertex_count; ++v) {
+            const float* n = &mesh.normals[v * 3];
+            const float l1 = std::abs(n[0]) + std::abs(n[1]) + std::abs(n[2]);
+            float x = l1 > 0.0f ? n[0] / l1 : 0.0f;
+            float y = l1 > 0.0f ? n[1] / l1 : 0.0f;
+            if (l1 > 0.0f && n[2] < 0.0f) {
+                const float folded_x = (1.0f - std::abs(y)) * signOf(x);
+                y = (1.0f - std::abs(x)) * signOf(y);
+                x = folded_x;
+            }
+            octahedral[v] = (int16_t)std::lround(std::clamp(x, -1.0f, 1.0f) * 32767.0f);
+            octahedral[vertex_count + v] = (int16_t)std::lround(std::clamp(y, -1.0f, 1.0f) * 32767.0f);
+        }
+        std::vector<uint8_t> body(octahedral.size() * sizeof(int16_t));
+        std::memcpy(body.data(), octahedral.data(), body.size());
+        appendSection(frame, kSectionNormals, kCodecOctahedral, body);
+    }
+
+    // Texcoords: unorm16 over the component's uv bounds, one plane per component
+    if (mesh.texcoords.size() == vertex_count * 2) {
+        float lo[2], hi[2];
+        for (int c = 0; c < 2; ++c) {
+            lo[c] = hi[c] = mesh.texcoords[c];
+            for (size_t v = 1; v < vertex_count; ++v) {
+                lo[c] = std::min(lo[c], mesh.texcoords[v * 2 + c]);
+                hi[c] = std::max(hi[c], mesh.texcoords[v * 2 + c]);
+            }
+        }
+        std::vector<uint8_t> body;
+        for (float bound : {lo[0], lo[1], hi[0], hi[1]}) writeRaw(body, bound);
+        std::vector<uint16_t> quantized(vertex_count * 2);
+        for (int c = 0; c < 2; ++c) {
+            const float scale = hi[c] > lo[c] ? 65535.0f / (hi[c] - lo[c]) : 0.0f;
+            for (size_t v = 0; v < vertex_count; ++v) {
+                quantized[c * vertex_count + v] = (uint16_t)std::lround((mesh.texcoords[v * 2 + c] - lo[c]) * scale);
+            }
+        }
+        const size_t header = body.size();
+        body.resize(header + quantized.size() * sizeof(uint16_t));
+        std::memcpy(body.data() + header, quantized.data(), quantized.size() * sizeof(uint16_t));
+        appendSection(frame, kSectionTexcoords, kCodecUnorm16, body);
+    }
+}
+
+void SpatialFrame::appendSession(std::vector<uint8_t>& frame, uint32_t epoch) {
+    std::vector<uint8_t> body;
+    writeVarint(body, epoch);
+    appendSection(frame, kSectionSession, kCodecRaw, body, false);
+}
+
+bool SpatialFrame::decode(const uint8_t* payload, size_t size, size_t max_vertices, bool progressive, MeshData& mesh,
+                          size_t& float_count, int& levels, uint32_t& epoch) {
+    ByteReader reader(payload, size);
+    uint8_t version = 0;
+    if (!reader.readRaw(version) || version != kVersion) return false;
+
+    mesh = MeshData();
+    epoch = 0;
+    bool have_layout = false, have_positions = false;
+    uint32_t vertex_count = 0;
+    uint64_t index_count = 0;
+    CanonicalHuffman librarian;
+    std::vector<uint8_t> packed, inflated;
+
+    while (reader.remaining() > 0) {
+        uint8_t id = 0;
+        uint32_t length = 0;
+        if (!reader.readRaw(id) || !reader.readVarint(length) || length < 1 || length > reader.remaining()) return false;
+        uint8_t codec = reader.ptr[0];
+        const uint8_t* body = reader.ptr + 1;
+        size_t body_size = length - 1;
+        reader.ptr += length;
+
+        if (id < kSectionLayout || id > kSectionSession) continue; // Newer section: skip by length
+        if (id != kSectionLayout && !have_layout) return false;
+        if (codec & kCodecEntropy) {
+            packed.assign(body, body + body_size);
+            inflated = librarian.decompress(packed);
+            body = inflated.data();
+            body_size = inflated.size();
+            codec &= (uint8_t)~kCodecEntropy;
+        }
+        ByteReader section(body, body_size);
+
+        if (id == kSectionLayout) {
+            // 1. Vertex count, depth and primitive slices
+            uint8_t depth = 0;
+            uint32_t primitive_count = 0;
+            if (have_layout || codec != kCodecRaw) return false;
+            if (!section.readVarint(vertex_count) || !section.readRaw(depth) || !section.readVarint(primitive_count)) return false;
+            if (vertex_count > max_vertices) return false;
+            if (depth < 1 || depth > kMaxHaarLevels || primitive_count > section.remaining() / 2) return false;
+            uint64_t vertex_cursor = 0;
+            for (uint32_t p = 0; p < primitive_count; ++p) {
+                PrimitiveRange range;
+                if (!section.readVarint(range.vertex_count) || !section.readVarint(range.index_count)) return false;
+                range.vertex_first = (uint32_t)vertex_cursor;
+                range.index_first = (uint32_t)index_count;
+                vertex_cursor += range.vertex_count;
+                index_count += range.index_count;
+                if (vertex_cursor > vertex_count || index_count > UINT32_MAX) return false;
+                mesh.primitives.push_back(range);
+            }
+            if (vertex_cursor != vertex_count) return false;
+            levels = depth;
+            float_count = (size_t)vertex_count * 3;
+            have_layout = true;
+        } else if (id == kSectionPositions) {
+            // 2. Coefficients: everything, or the approximation band of a progressive base
+            uint8_t bits = 0;
+            float steps[3];
+            if (codec != kCodecSignificance || !section.readRaw(bits)) return false;
+            for (float& step : steps) {
+                if (!section.readRaw(step)) return false;
+            }
+            const size_t sent = progressive ? haarBandSizes(vertex_count, levels)[0] : vertex_count;
+            if (!CoefficientCodec::decodeSignificance(section.ptr, section.remaining(), (uint32_t)sent, steps, mesh.vertices)) return false;
+            have_positions = true;
+        } else if (id == kSectionTopology) {
+            // 3. Indices, raw (16-bit below 65536 vertices) or IndexCodec
+            if (codec == kCodecRaw) {
+                const size_t width = vertex_count < 65536 ? sizeof(uint16_t) : sizeof(uint32_t);
+                if (body_size != index_count * width) return false;
+                mesh.indices.resize(index_count);
+                for (size_t i = 0; i < mesh.indices.size(); ++i) {
+                    mesh.indices[i] = width == sizeof(uint16_t) ? readAt<uint16_t>(body, i) : readAt<uint32_t>(body, i);
+                }
+            } else if (codec == kCodecIndexCodec) {
+                std::vector<uint8_t> stream(body, body + body_size);
+                if (!IndexCodec::decode(stream, mesh.indices) || mesh.indices.size() != index_count) return false;
+            } else {
+                return false;
+            }
+            for (uint32_t idx : mesh.indices) {
+                if (idx >= vertex_count) return false;
+            }
+        } else if (id == kSectionNormals) {
+            // 4. Octahedral normals back onto the unit sphere
+            if (codec != kCodecOctahedral || body_size != (size_t)vertex_count * 2 * sizeof(int16_t)) return false;
+            mesh.normals.resize((size_t)vertex_count * 3);
+            for (size_t v = 0; v < vertex_count; ++v) {
+                float x = readAt<int16_t>(body, v) / 32767.0f;
+                float y = readAt<int16_t>(body, vertex_count + v) / 32767.0f;
+                const float z = 1.0f - std::abs(x) - std::abs(y);
+                if (z < 0.0f) {
+                    const float folded_x = (1.0f - std::abs(y)) * signOf(x);
+                    y = (1.0f - std::abs(x)) * signOf(y);
+                    x = folded_x;
+                }
+                const float length = std::sqrt(x * x + y * y + z * z);
+                mesh.normals[v * 3] = x / length;
+                mesh.normals[v * 3 + 1] = y / length;
+                mesh.normals[v * 3 + 2] = z / length;
+            }
+        } else if (id == kSectionTexcoords) {
+            // 5. Unorm16 texcoords over the transmitted bounds
+            float bounds[4];
+            if (codec != kCodecUnorm16) return false;
+            for (float& bound : bounds) {
+                if (!section.readRaw(bound)) return false;
+            }
+            if (section.remaining() != (size_t)vertex_count * 2 * sizeof(uint16_t)) return false;
+            mesh.texcoords.resize((size_t)vertex_count * 2);
+            for (int c = 0; c < 2; ++c) {
+                const float scale = (bounds[2 + c] - bounds[c]) / 65535.0f;
+                for (size_t v = 0; v < vertex_count; ++v) {
+                    mesh.texcoords[v * 2 + c] = bounds[c] + readAt<uint16_t>(section.ptr, c * vertex_count + v) * scale;
+                }
+            }
+        } else if (id == kSectionSession) {
+            // 6. Keyframe epoch for the delta session
+            if (codec != kCodecRaw || !section.readVarint(epoch) || epoch == 0) return false;
+        }
+    }
+
+    return have_layout && have_positions && mesh.indices.size() == index_count;
+}
@@ -0,0 +1,76 @@
+#ifndef SPATIAL_FRAME_H
+#define SPATIAL_FRAME_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "SpatialPacker.h"
+
+/**
+ * Sectioned Frame Aura Check:
+ * The original base frame was [u32 size][coefficient stream][topology stream], with the float
+ * count smuggled through QuasarHeader::width: one vertex block, one topology blob, and fixed
+ * stream headers plus a 128-byte Huffman length table each, whatever the component's size.
+ * Base frames (file_type 0x03) now set kFlagSectioned and carry a versioned list of sections:
+ *   [u8 version][section]...    section = [u8 id][varint length][u8 codec][body]
+ * - Layout (first): [varint vertex_count][u8 levels][varint primitive_count] then
+ *   [varint vertex_count][varint index_count] per primitive. Primitives tile the vertex and
+ *   index buffers in order, so their first vertex / first index follow from the counts.
+ * - Positions: [u8 bits][f32 step X/Y/Z][significance body] (CoefficientCodec stage 2; the
+ *   layout already carries the count and depth). A progressive base holds the approximation band.
+ * - Topology: raw little-endian indices, 16-bit whenever vertex_count < 65536, or an IndexCodec
+ *   stream, whichever is smaller.
+ * - Normals: octahedral, one int16 plane per component. Texcoords: [f32 min u/v][f32 max u/v]
+ *   then one u16 plane per component.
+ * - Session (session keyframes only): [varint epoch], the keyframe number later deltas name.
+ * Each body is also run through CanonicalHuffman and sent that way (codec | kCodecEntropy) only
+ * when that is smaller, so a small component pays a few bytes of framing instead of fixed
+ * headers and length tables. Unknown section ids are skipped by length. The layout's vertex
+ * count is checked against the caller's max_vertices (QuasarHeader::original_size / 12 on
+ * RX) before anything is sized from it, since zero runs let a tiny payload claim any count.
+ */
+
+constexpr uint8_t kFlagSectioned = 0x80;
+
+class SpatialFrame {
+public:
+    static constexpr uint8_t kVersion = 1;
+
+    static constexpr uint8_t kSectionLayout = 1;
+    static constexpr uint8_t kSectionPositions = 2;
+    static constexpr uint8_t kSectionTopology = 3;
+    static constexpr uint8_t kSectionNormals = 4;
+    static constexpr uint8_t kSectionTexcoords = 5;
+    static constexpr uint8_t kSectionSession = 6;
+
+    static constexpr uint8_t kCodecRaw = 0;
+    static constexpr uint8_t kCodecSignificance = 1;
+    static constexpr uint8_t kCodecIndexCodec = 2;
+    static constexpr uint8_t kCodecOctahedral = 3;
+    static constexpr uint8_t kCodecUnorm16 = 4;
+    static constexpr uint8_t kCodecEntropy = 0x80;
+
+    // Full payload for `mesh`, whose vertices hold the (thresholded) coefficients; only the first
+    // `count` floats are sent as positions. IndexCodec may rotate mesh.indices in place to match
+    // what the receiver decodes.
+    static std::vector<uint8_t> encode(MeshData& mesh, size_t count, int bits, int levels);
+
+    // Section builders behind encode(), also used by RateControl to size frames
+    static void appendLayout(std::vector<uint8_t>& frame, const MeshData& mesh, int levels);
+    static void appendPositions(std::vector<uint8_t>& frame, const float* coefficients, size_t count, int bits);
+    static void appendTopology(std::vector<uint8_t>& frame, std::vector<uint32_t>& indices, size_t vertex_count);
+    static void appendAttributes(std::vector<uint8_t>& frame, const MeshData& mesh);
+
+    // Size appendTopology would add, without reordering `indices` or logging
+    static size_t topologyBytes(const std::vector<uint32_t>& indices, size_t vertex_count);
+    static void appendSession(std::vector<uint8_t>& frame, uint32_t epoch);
+
+    // Parses a payload into `mesh` (vertices = decoded coefficients: the approximation band only
+    // when `progressive`). float_count and levels describe the full transform; epoch is the
+    // session keyframe epoch, 0 without a session section. Returns false on a malformed or
+    // truncated payload, or one with more than max_vertices vertices.
+    static bool decode(const uint8_t* payload, size_t size, size_t max_vertices, bool progressive, MeshData& mesh, size_t& float_count,
+                       int& levels, uint32_t& epoch);
+};
+
+#endif // SPATIAL_FRAME_H
@@ -1,14 +1,142 @@
 #define CGLTF_IMPLEMENTATION
 #include "../include/third_party/cgltf.h"
 #include "SpatialPacker.h"
-#include "../lib/quasar_core/wavelet.h"
+#include "HaarTransform.h"
 #include <vector>
 #include <iostream>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * Zero-Copy Ingestion Aura Check:
+ * cgltf_parse_file reads the whole GLB into a heap buffer before parsing. Mapping the file
+ * instead lets cgltf_parse run over the page cache, and cgltf_load_buffers points the embedded
+ * BIN chunk straight at the mapping (data_free_method_none) rather than copying it. The mapping
+ * must therefore outlive cgltf_free.
+ * Accessors in the common layout (float VEC3 positions; u8/u16/u32 indices; not sparse) are read
+ * with one strided pass into a pre-sized MeshData; a tight stride collapses to a single memcpy.
+ * Anything else falls back to cgltf's per-element readers.
+ */
+namespace {
+class MappedFile {
+public:
+    explicit MappedFile(const char* path) {
+        fd_ = open(path, O_RDONLY);
+        if (fd_ < 0) return;
+        struct stat st;
+        if (fstat(fd_, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size == 0) return;
+        void* mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd_, 0);
+        if (mapped == MAP_FAILED) return;
+        madvise(mapped, (size_t)st.st_size, MADV_WILLNEED);
+        data_ = mapped;
+        size_ = (size_t)st.st_size;
+    }
+
+    ~MappedFile() {
+        if (data_) munmap(data_, size_);
+        if (fd_ >= 0) close(fd_);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const void* data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    int fd_ = -1;
+    void* data_ = nullptr;
+    size_t size_ = 0;
+};
+
+// First element of a dense accessor, or nullptr when the layout needs cgltf's generic reader
+const uint8_t* accessorBase(const cgltf_accessor* accessor, cgltf_size element_size) {
+    const cgltf_buffer_view* view = accessor->buffer_view;
+    if (accessor->is_sparse || !view || !view->buffer->data || accessor->count == 0) return nullptr;
+    if (accessor->stride < element_size) return nullptr;
+    if (accessor->offset + accessor->stride * (accessor->count - 1) + element_size > view->size) return nullptr;
+    if (!view->data && view->offset + view->size > view->buffer->size) return nullptr;
+    return cgltf_buffer_view_data(view) + accessor->offset;
+}
+
+void readFloats(const cgltf_accessor* accessor, float* out) {
+    const cgltf_size num_components = cgltf_num_components(accessor->type);
+    const uint8_t* base = nullptr;
+    if (accessor->component_type == cgltf_component_type_r_32f && !accessor->normalized) {
+        base = accessorBase(accessor, num_components * sizeof(float));
+    }
+
+    if (base) {
+        const size_t row = num_components * sizeof(float);
+        if (accessor->stride == row) {
+            std::memcpy(out, base, row * accessor->count);
+        } else {
+            for (cgltf_size v = 0; v < accessor->count; ++v) {
+                std::memcpy(out + v * num_components, base + v * accessor->stride, row);
+            }
+        }
+        return;
+    }
+
+    for (cgltf_size v = 0; v < accessor->count; ++v) {
+        float v_data[16];
+        if (cgltf_accessor_read_float(accessor, v, v_data, 16)) {
+            std::copy(v_data, v_data + num_components, out + v * num_components);
+        }
+    }
+}
+
+template <typename T>
+void widenIndices(const uint8_t* base, cgltf_size stride, cgltf_size count, uint32_t* out) {
+    for (cgltf_size v = 0; v < count; ++v) {
+        T value;
+        std::memcpy(&value, base + v * stride, sizeof(T));
+        out[v] = value;
+    }
+}
+
+void readIndices(const cgltf_accessor* accessor, uint32_t* out) {
+    const cgltf_size size = cgltf_component_size(accessor->component_type);
+    const uint8_t* base = accessor->type == cgltf_type_scalar ? accessorBase(accessor, size) : nullptr;
+
+    if (base && accessor->component_type == cgltf_component_type_r_32u && accessor->stride == sizeof(uint32_t)) {
+        std::memcpy(out, base, accessor->count * sizeof(uint32_t));
+    } else if (base && accessor->component_type == cgltf_component_type_r_32u) {
+        widenIndices<uint32_t>(base, accessor->stride, accessor->count, out);
+    } else if (base && accessor->component_type == cgltf_component_type_r_16u) {
+        widenIndices<uint16_t>(base, accessor->stride, accessor->count, out);
+    } else if (base && accessor->component_type == cgltf_component_type_r_8u) {
+        widenIndices<uint8_t>(base, accessor->stride, accessor->count, out);
+    } else {
+        for (cgltf_size v = 0; v < accessor->count; ++v) {
+            out[v] = (uint32_t)cgltf_accessor_read_index(accessor, v);
+        }
+    }
+}
+
+const cgltf_accessor* findAttribute(const cgltf_primitive& prim, cgltf_attribute_type type, cgltf_size width) {
+    for (cgltf_size k = 0; k < prim.attributes_count; ++k) {
+        const cgltf_attribute& attribute = prim.attributes[k];
+        if (attribute.type == type && attribute.index == 0 && cgltf_num_components(attribute.data->type) == width) return attribute.data;
+    }
+    return nullptr;
+}
+} // namespace
 
 std::vector<MeshData> SpatialPacker::extractMeshData(const char* path) {
     cgltf_options options = {};
     cgltf_data* data = nullptr;
-    cgltf_result result = cgltf_parse_file(&options, path, &data);
+
+    // Prefer the zero-copy mapping; fall back to cgltf's own reader for non-regular files
+    MappedFile mapping(path);
+    cgltf_result result = mapping.data()
+        ? cgltf_parse(&options, mapping.data(), mapping.size(), &data)
+        : cgltf_parse_file(&options, path, &data);
 
     if (result != cgltf_result_success) {
         std::cerr << "Failed to parse GLB: " << path << std::endl;
@@ -23,6 +151,7 @@ std::vector<MeshData> SpatialPacker::extractMeshData(const char* path) {
     }
 
     std::vector<MeshData> sceneData;
+    sceneData.reserve(data->nodes_count);
 
     // Traverse nodes to associate names with meshes
     for (cgltf_size i = 0; i < data->nodes_count; ++i) {
@@ -32,33 +161,58 @@ std::vector<MeshData> SpatialPacker::extractMeshData(const char* path) {
         MeshData meshData;
         meshData.name = node->name ? node->name : "unnamed_component";
 
+        // 1. Size the component up front so every primitive lands with a single bulk copy
+        size_t total_vertices = 0, total_indices = 0;
+        bool has_normals = false, has_texcoords = false;
         for (cgltf_size j = 0; j < node->mesh->primitives_count; ++j) {
-            cgltf_primitive& prim = node->mesh->primitives[j];
-
-            // 1. Extract Vertices (Position)
-            for (cgltf_size k = 0; k < prim.attributes_count; ++k) {
-                if (prim.attributes[k].type == cgltf_attribute_type_position) {
-                    cgltf_accessor* accessor = prim.attributes[k].data;
-                    cgltf_size num_components = cgltf_num_components(accessor->type);
-
-                    for (cgltf_size v = 0; v < accessor->count; ++v) {
-                        float v_data[16];
-                        if (cgltf_accessor_read_float(accessor, v, v_data, 16)) {
-                            for (cgltf_size c = 0; c < num_components; ++c) {
-                                meshData.vertices.push_back(v_data[c]);
-                            }
-                        }
-                    }
-                }
+            const cgltf_primitive& prim = node->mesh->primitives[j];
+            const cgltf_accessor* position = findAttribute(prim, cgltf_attribute_type_position, 3);
+            if (!position) continue;
+            total_vertices += position->count;
+            total_indices += prim.indices ? prim.indices->count : prim.type == cgltf_primitive_type_triangles ? position->count : 0;
+            has_normals |= findAttribute(prim, cgltf_attribute_type_normal, 3) != nullptr;
+            has_texcoords |= findAttribute(prim, cgltf_attribute_type_texcoord, 2) != nullptr;
+        }
+        meshData.vertices.resize(total_vertices * 3);
+        meshData.indices.resize(total_indices);
+        if (has_normals) meshData.normals.resize(total_vertices * 3, 0.0f);
+        if (has_texcoords) meshData.texcoords.resize(total_vertices * 2, 0.0f);
+
+        uint32_t vertex_cursor = 0, index_cursor = 0;
+        for (cgltf_size j = 0; j < node->mesh->primitives_count; ++j) {
+            const cgltf_primitive& prim = node->mesh->primitives[j];
+            const cgltf_accessor* position = findAttribute(prim, cgltf_attribute_type_position, 3);
+            if (!position) continue;
+
+            // 2. Extract Vertices (Position) and optional attributes
+            PrimitiveRange range;
+            range.vertex_first = vertex_cursor;
+            range.vertex_count = (uint32_t)position->count;
+            range.index_first = index_cursor;
+            readFloats(position, meshData.vertices.data() + (size_t)vertex_cursor * 3);
+            if (const cgltf_accessor* normal = findAttribute(prim, cgltf_attribute_type_normal, 3)) {
+                if (normal->count == position->count) readFloats(normal, meshData.normals.data() + (size_t)vertex_cursor * 3);
+            }
+            if (const cgltf_accessor* texcoord = findAttribute(prim, cgltf_attribute_type_texcoord, 2)) {
+                if (texcoord->count == position->count) readFloats(texcoord, meshData.texcoords.data() + (size_t)vertex_cursor * 2);
             }
 
-            // 2. Extract Indices
+            // 3. Extract Indices, rebased onto the component's vertex buffer (non-indexed triangles index 0..n-1)
+            uint32_t* indices = meshData.indices.data() + index_cursor;
             if (prim.indices) {
-                cgltf_accessor* indexAccessor = prim.indices;
-                for (cgltf_size v = 0; v < indexAccessor->count; ++v) {
-                    meshData.indices.push_back((uint32_t)cgltf_accessor_read_index(indexAccessor, v));
-                }
+                readIndices(prim.indices, indices);
+                range.index_count = (uint32_t)prim.indices->count;
+            } else if (prim.type == cgltf_primitive_type_triangles) {
+                for (uint32_t v = 0; v < range.vertex_count; ++v) indices[v] = v;
+                range.index_count = range.vertex_count;
+            }
+            if (vertex_cursor > 0) {
+                for (uint32_t k = 0; k < range.index_count; ++k) indices[k] += vertex_cursor;
             }
+
+            vertex_cursor += range.vertex_count;
+            index_cursor += range.index_count;
+            meshData.primitives.push_back(range);
         }
         sceneData.push_back(std::move(meshData));
     }
@@ -67,91 +221,609 @@ std::vector<MeshData> SpatialPacker::extractMeshData(const char* path) {
     return sceneData;
 }
 
-void SpatialPacker::compressMesh(std::vector<float>& vertices, float threshold) {
+void SpatialPacker::compressMesh(std::vector<float>& vertices, float threshold, int levels) {
+    if (vertices.empty()) return;
+
+    // 1. Multi-level Haar directly on the interleaved xyz buffer
+    transformMesh(vertices, levels);
+
+    // 2. Apply Geometry Saliency
+    applyThresholds(vertices, {threshold, threshold, threshold});
+
+    std::cout << "[Spatial] Interleaved Wavelet compression complete (" << levels << " level(s))." << std::endl;
+}
+
+void SpatialPacker::transformMesh(std::vector<float>& vertices, int levels) {
     if (vertices.empty()) return;
+    haarForwardInterleaved(vertices.data(), vertices.size() / 3, levels, scratch_);
+}
+
+void SpatialPacker::applyThresholds(std::vector<float>& coefficients, const PlaneThresholds& thresholds) {
+    for (size_t i = 0; i < coefficients.size(); ++i) {
+        if (std::abs(coefficients[i]) < thresholds[i % 3]) coefficients[i] = 0.0f;
+    }
+}
+
+/**
+ * Vertex Cache Aura Check (Forsyth, "Linear-Speed Vertex Cache Optimisation"):
+ * Triangles are emitted greedily by score. A vertex scores high when it sits near the front of
+ * a simulated 32-entry LRU cache and when few of its triangles remain, so the walk finishes
+ * fans before moving on. Consecutive triangles then share vertices, and renumbering vertices in
+ * first-use order afterwards turns every fresh vertex into "high-water mark + 1", which is
+ * exactly what IndexCodec predicts.
+ */
+namespace {
+constexpr int kCacheSize = 32;
+constexpr int kMaxValenceScore = 32;
+
+struct ForsythScores {
+    float cache[kCacheSize];
+    float valence[kMaxValenceScore];
+
+    ForsythScores() {
+        for (int i = 0; i < kCacheSize; ++i) {
+            cache[i] = i < 3 ? 0.75f : std::pow(1.0f - (float)(i - 3) / (kCacheSize - 3), 1.5f);
+        }
+        valence[0] = 0.0f;
+        for (int i = 1; i < kMaxValenceScore; ++i) valence[i] = 2.0f / std::sqrt((float)i);
+    }
+
+    float vertex(int cache_pos, uint32_t remaining) const {
+        if (remaining == 0) return -1.0f;
+        float score = cache_pos >= 0 ? cache[cache_pos] : 0.0f;
+        return score + valence[std::min<uint32_t>(remaining, kMaxValenceScore - 1)];
+    }
+};
+
+// Forsyth order for one primitive's triangle list, with indices local to [0, vertex_count)
+void orderTriangles(std::vector<uint32_t>& indices, uint32_t vertex_count) {
+    static const ForsythScores scores;
+    const size_t tri_count = indices.size() / 3;
 
-    size_t num_vertices = vertices.size() / 3;
-    std::vector<float> X(num_vertices), Y(num_vertices), Z(num_vertices);
+    // 1. Vertex -> triangle adjacency (CSR)
+    std::vector<uint32_t> offsets(vertex_count + 1, 0);
+    for (uint32_t idx : indices) offsets[idx + 1]++;
+    for (uint32_t v = 0; v < vertex_count; ++v) offsets[v + 1] += offsets[v];
+    std::vector<uint32_t> adjacency(indices.size());
+    std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (size_t i = 0; i < indices.size(); ++i) adjacency[fill[indices[i]]++] = (uint32_t)(i / 3);
 
-    // 1. De-interleave (Spatial -> Planar)
-    for (size_t i = 0; i < num_vertices; ++i) {
-        X[i] = vertices[i * 3 + 0];
-        Y[i] = vertices[i * 3 + 1];
-        Z[i] = vertices[i * 3 + 2];
+    std::vector<uint32_t> remaining(vertex_count);
+    std::vector<int> cache_pos(vertex_count, -1);
+    std::vector<float> vertex_score(vertex_count);
+    for (uint32_t v = 0; v < vertex_count; ++v) {
+        remaining[v] = offsets[v + 1] - offsets[v];
+        vertex_score[v] = scores.vertex(-1, remaining[v]);
     }
 
-    // 2. Apply Wavelet Transform to each plane independently
-    // This prevents the X coordinate of one point from "bleeding" into the Y of another
-    haar1D(X, (int)X.size());
-    haar1D(Y, (int)Y.size());
-    haar1D(Z, (int)Z.size());
+    std::vector<float> tri_score(tri_count);
+    std::vector<uint8_t> emitted(tri_count, 0);
+    for (size_t t = 0; t < tri_count; ++t) {
+        tri_score[t] = vertex_score[indices[t * 3]] + vertex_score[indices[t * 3 + 1]] + vertex_score[indices[t * 3 + 2]];
+    }
 
-    // 3. Apply Geometry Saliency
-    auto filter = [&](std::vector<float>& plane) {
-        for (float& val : plane) {
-            if (std::abs(val) < threshold) val = 0.0f;
+    // 2. Greedy emission with a simulated LRU cache
+    std::vector<uint32_t> output;
+    output.reserve(indices.size());
+    uint32_t cache[kCacheSize + 3];
+    int cache_used = 0;
+    size_t best = std::max_element(tri_score.begin(), tri_score.end()) - tri_score.begin();
+    size_t scan_cursor = 0;
+
+    for (size_t emitted_count = 0; emitted_count < tri_count; ++emitted_count) {
+        if (best == tri_count) {
+            // Cache ran dry: fall back to the next unemitted triangle in input order
+            while (emitted[scan_cursor]) ++scan_cursor;
+            best = scan_cursor;
+        }
+
+        const uint32_t* tri = &indices[best * 3];
+        emitted[best] = 1;
+        output.insert(output.end(), tri, tri + 3);
+
+        // Retire the triangle from its vertices' adjacency lists
+        for (int k = 0; k < 3; ++k) {
+            const uint32_t v = tri[k];
+            uint32_t* begin = &adjacency[offsets[v]];
+            uint32_t* end = begin + remaining[v];
+            *std::find(begin, end, (uint32_t)best) = *(end - 1);
+            remaining[v]--;
         }
-    };
-    filter(X); filter(Y); filter(Z);
 
-    // 4. Re-interleave back to main vector
-    for (size_t i = 0; i < num_vertices; ++i) {
-        vertices[i * 3 + 0] = X[i];
-        vertices[i * 3 + 1] = Y[i];
-        vertices[i * 3 + 2] = Z[i];
+        // Move the triangle's vertices to the cache front
+        uint32_t new_cache[kCacheSize + 3];
+        int new_used = 0;
+        for (int k = 0; k < 3; ++k) {
+            if (std::find(new_cache, new_cache + new_used, tri[k]) == new_cache + new_used) new_cache[new_used++] = tri[k];
+        }
+        for (int i = 0; i < cache_used; ++i) {
+            const uint32_t v = cache[i];
+            if (std::find(new_cache, new_cache + new_used, v) == new_cache + new_used) new_cache[new_used++] = v;
+        }
+
+        // Rescore everything that was or is in the cache, then pick the best neighbour
+        float best_score = -1.0f;
+        best = tri_count;
+        for (int i = 0; i < new_used; ++i) {
+            const uint32_t v = new_cache[i];
+            cache_pos[v] = i < kCacheSize ? i : -1;
+            vertex_score[v] = scores.vertex(cache_pos[v], remaining[v]);
+        }
+        for (int i = 0; i < new_used; ++i) {
+            const uint32_t v = new_cache[i];
+            for (uint32_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+                const uint32_t t = adjacency[a];
+                const uint32_t* n = &indices[t * 3];
+                tri_score[t] = vertex_score[n[0]] + vertex_score[n[1]] + vertex_score[n[2]];
+                if (tri_score[t] > best_score) {
+                    best_score = tri_score[t];
+                    best = t;
+                }
+            }
+        }
+
+        cache_used = std::min(new_used, kCacheSize);
+        std::copy(new_cache, new_cache + cache_used, cache);
     }
-    
-    std::cout << "[Spatial] Planar Wavelet compression complete." << std::endl;
+
+    indices.swap(output);
 }
 
-void SpatialPacker::decompressMesh(std::vector<float>& vertices) {
-    if (vertices.empty()) return;
+// Slices must tile the vertex and index buffers in order, and every index must stay in its slice
+bool rangesConsistent(const MeshData& mesh, const std::vector<PrimitiveRange>& ranges) {
+    uint32_t vertex_cursor = 0, index_cursor = 0;
+    for (const PrimitiveRange& range : ranges) {
+        if (range.vertex_first != vertex_cursor || range.index_first != index_cursor) return false;
+        for (uint32_t k = 0; k < range.index_count; ++k) {
+            const uint32_t idx = mesh.indices[range.index_first + k];
+            if (idx < range.vertex_first || idx - range.vertex_first >= range.vertex_count) return false;
+        }
+        vertex_cursor += range.vertex_count;
+        index_cursor += range.index_count;
+    }
+    return vertex_cursor == mesh.vertices.size() / 3 && index_cursor == mesh.indices.size();
+}
+} // namespace
+
+std::vector<PrimitiveRange> SpatialPacker::primitiveRanges(const MeshData& mesh) {
+    if (!mesh.primitives.empty()) return mesh.primitives;
+    PrimitiveRange whole;
+    whole.vertex_count = (uint32_t)(mesh.vertices.size() / 3);
+    whole.index_count = (uint32_t)mesh.indices.size();
+    return {whole};
+}
 
-    size_t num_vertices = vertices.size() / 3;
-    std::vector<float> X(num_vertices), Y(num_vertices), Z(num_vertices);
+void SpatialPacker::optimizeTopology(MeshData& mesh) {
+    const std::vector<PrimitiveRange> ranges = primitiveRanges(mesh);
+    if (mesh.indices.size() < 6 || !rangesConsistent(mesh, ranges)) return;
 
-    // 1. De-interleave
-    for (size_t i = 0; i < num_vertices; ++i) {
-        X[i] = vertices[i * 3 + 0];
-        Y[i] = vertices[i * 3 + 1];
-        Z[i] = vertices[i * 3 + 2];
+    // 1-2. Forsyth order inside each primitive
+    std::vector<uint32_t> local;
+    for (const PrimitiveRange& range : ranges) {
+        if (range.index_count < 6 || range.index_count % 3 != 0) continue;
+        uint32_t* indices = mesh.indices.data() + range.index_first;
+        local.assign(indices, indices + range.index_count);
+        for (uint32_t& idx : local) idx -= range.vertex_first;
+        orderTriangles(local, range.vertex_count);
+        for (uint32_t k = 0; k < range.index_count; ++k) indices[k] = local[k] + range.vertex_first;
     }
 
-    // 2. Inverse Haar on each plane
-    invHaar1D(X, (int)X.size());
-    invHaar1D(Y, (int)Y.size());
-    invHaar1D(Z, (int)Z.size());
+    // 3. Renumber vertices in first-use order within each primitive; unreferenced vertices keep
+    //    their relative order at the end of their primitive
+    std::vector<uint32_t> remap(mesh.vertices.size() / 3, UINT32_MAX);
+    for (const PrimitiveRange& range : ranges) {
+        uint32_t next_vertex = range.vertex_first;
+        for (uint32_t k = 0; k < range.index_count; ++k) {
+            const uint32_t idx = mesh.indices[range.index_first + k];
+            if (remap[idx] == UINT32_MAX) remap[idx] = next_vertex++;
+        }
+        for (uint32_t v = range.vertex_first; v < range.vertex_first + range.vertex_count; ++v) {
+            if (remap[v] == UINT32_MAX) remap[v] = next_vertex++;
+        }
+    }
+    applyVertexRemap(mesh, remap);
+}
 
-    // 3. Re-interleave
-    for (size_t i = 0; i < num_vertices; ++i) {
-        vertices[i * 3 + 0] = X[i];
-        vertices[i * 3 + 1] = Y[i];
-        vertices[i * 3 + 2] = Z[i];
+/**
+ * Spatial Ordering Aura Check:
+ * Haar detail coefficients are differences between neighbouring samples, so they only stay
+ * small when neighbours in the buffer are neighbours in space. Sorting vertices by the Morton
+ * code of their position (21 bits per axis over the primitive's bounding box) gives exactly
+ * that locality; vertices never leave their primitive's slice. The permutation is never
+ * transmitted: indices are remapped on the TX side, so the receiver simply gets a differently
+ * ordered but identical mesh. Triangle order is left as the source had it; running
+ * optimizeTopology afterwards would renumber vertices again.
+ */
+namespace {
+uint64_t spreadBits21(uint64_t v) {
+    v &= 0x1FFFFF;
+    v = (v | (v << 32)) & 0x1F00000000FFFFull;
+    v = (v | (v << 16)) & 0x1F0000FF0000FFull;
+    v = (v | (v << 8)) & 0x100F00F00F00F00Full;
+    v = (v | (v << 4)) & 0x10C30C30C30C30C3ull;
+    v = (v | (v << 2)) & 0x1249249249249249ull;
+    return v;
+}
+} // namespace
+
+void SpatialPacker::reorderSpatially(MeshData& mesh) {
+    const std::vector<uint32_t> remap = spatialOrder(mesh);
+    if (!remap.empty()) applyVertexRemap(mesh, remap);
+}
+
+std::vector<uint32_t> SpatialPacker::spatialOrder(const MeshData& mesh) {
+    const std::vector<PrimitiveRange> ranges = primitiveRanges(mesh);
+    if (mesh.vertices.size() / 3 < 2 || !rangesConsistent(mesh, ranges)) return {};
+
+    std::vector<uint32_t> remap(mesh.vertices.size() / 3);
+    std::vector<std::pair<uint64_t, uint32_t>> keyed;
+    for (const PrimitiveRange& range : ranges) {
+        if (range.vertex_count == 0) continue;
+        const float* vertices = mesh.vertices.data() + (size_t)range.vertex_first * 3;
+
+        // 1. Quantized bounding box of the primitive
+        float lo[3], hi[3];
+        for (int c = 0; c < 3; ++c) lo[c] = hi[c] = vertices[c];
+        for (size_t v = 0; v < range.vertex_count; ++v) {
+            for (int c = 0; c < 3; ++c) {
+                lo[c] = std::min(lo[c], vertices[v * 3 + c]);
+                hi[c] = std::max(hi[c], vertices[v * 3 + c]);
+            }
+        }
+        const float cells = (float)((1u << 21) - 1);
+        float scale[3];
+        for (int c = 0; c < 3; ++c) scale[c] = hi[c] > lo[c] ? cells / (hi[c] - lo[c]) : 0.0f;
+
+        // 2. Sort by Morton code; ties keep input order so the result is deterministic
+        keyed.resize(range.vertex_count);
+        for (size_t v = 0; v < range.vertex_count; ++v) {
+            uint64_t code = 0;
+            for (int c = 0; c < 3; ++c) {
+                const float cell = (vertices[v * 3 + c] - lo[c]) * scale[c];
+                code |= spreadBits21(cell > 0.0f ? (uint64_t)std::min(cell, cells) : 0) << c;
+            }
+            keyed[v] = {code, (uint32_t)v};
+        }
+        std::sort(keyed.begin(), keyed.end());
+
+        for (size_t rank = 0; rank < range.vertex_count; ++rank) {
+            remap[range.vertex_first + keyed[rank].second] = range.vertex_first + (uint32_t)rank;
+        }
     }
-    std::cout << "[Receiver] Inverse Planar Haar completed." << std::endl;
+    return remap;
+}
+
+void SpatialPacker::applyVertexRemap(MeshData& mesh, const std::vector<uint32_t>& remap) {
+    auto permute = [&remap](std::vector<float>& values, size_t width) {
+        if (values.size() != remap.size() * width) return;
+        std::vector<float> reordered(values.size());
+        for (size_t v = 0; v < remap.size(); ++v) {
+            std::copy(&values[v * width], &values[v * width] + width, &reordered[(size_t)remap[v] * width]);
+        }
+        values.swap(reordered);
+    };
+    permute(mesh.vertices, 3);
+    permute(mesh.normals, 3);
+    permute(mesh.texcoords, 2);
+    for (uint32_t& idx : mesh.indices) idx = remap[idx];
 }
 
-#include <fstream>
-void SpatialPacker::saveAsOBJ(const std::string& path, const std::vector<float>& vertices, const std::vector<uint32_t>& indices) {
-    std::cout << "[Debug] Saving OBJ with " << vertices.size()/3 << " vertices and " << indices.size()/3 << " faces." << std::endl;
-    std::ofstream file(path);
-    if (!file.is_open()) {
+void SpatialPacker::decompressMesh(std::vector<float>& vertices, int levels) {
+    if (vertices.empty()) return;
+
+    haarInverseInterleaved(vertices.data(), vertices.size() / 3, levels, scratch_);
+    std::cout << "[Receiver] Inverse Interleaved Haar completed." << std::endl;
+}
+
+#include <charconv>
+#include <cstdio>
+
+namespace {
+// Accumulates output in one large buffer and hands it to the OS kBufferSize bytes at a time.
+// Writes go to "<path>.tmp", which close() renames over `path` only once everything landed, so
+// a reader polling the export never sees a half-written file.
+class BufferedWriter {
+public:
+    static constexpr size_t kBufferSize = 4 << 20;
+
+    explicit BufferedWriter(const std::string& path)
+        : path_(path), temp_path_(path + ".tmp"), file_(std::fopen(temp_path_.c_str(), "wb")), buffer_(kBufferSize) {}
+
+    // Abandoned without close(): discard the partial file, leave `path` untouched
+    ~BufferedWriter() {
+        if (!file_) return;
+        std::fclose(file_);
+        std::remove(temp_path_.c_str());
+    }
+
+    bool isOpen() const { return file_ != nullptr; }
+
+    // Returns room for at least `size` bytes; pass the end of what was written to commit()
+    char* reserve(size_t size) {
+        if (used_ + size > buffer_.size()) flush();
+        return buffer_.data() + used_;
+    }
+    void commit(char* end) { used_ = (size_t)(end - buffer_.data()); }
+
+    void write(const void* data, size_t size) {
+        if (size > buffer_.size()) {
+            flush();
+            if (file_ && std::fwrite(data, 1, size, file_) != size) failed_ = true;
+            return;
+        }
+        char* out = reserve(size);
+        std::memcpy(out, data, size);
+        commit(out + size);
+    }
+
+    void pad(size_t size, char value) {
+        char* out = reserve(size);
+        std::memset(out, value, size);
+        commit(out + size);
+    }
+
+    // Flushes, closes and moves the file into place; false (and `path` untouched) if any step failed
+    bool close() {
+        if (!file_) return !failed_;
+        flush();
+        if (std::fclose(file_) != 0) failed_ = true;
+        file_ = nullptr;
+        if (!failed_ && std::rename(temp_path_.c_str(), path_.c_str()) != 0) failed_ = true;
+        if (failed_) std::remove(temp_path_.c_str());
+        return !failed_;
+    }
+
+private:
+    void flush() {
+        if (file_ && used_ > 0 && std::fwrite(buffer_.data(), 1, used_, file_) != used_) failed_ = true;
+        used_ = 0;
+    }
+
+    std::string path_;
+    std::string temp_path_;
+    std::FILE* file_;
+    std::vector<char> buffer_;
+    size_t used_ = 0;
+    bool failed_ = false;
+};
+
+// Shortest round-trip float text is at most 15 characters ("-1.17549435e-38")
+constexpr size_t kMaxNumberChars = 16;
+
+char* writeNumber(char* out, float value) { return std::to_chars(out, out + kMaxNumberChars, value).ptr; }
+char* writeNumber(char* out, uint64_t value) { return std::to_chars(out, out + kMaxNumberChars + 4, value).ptr; }
+} // namespace
+
+void SpatialPacker::saveAsOBJ(const std::string& path, const MeshData& mesh) {
+    const std::vector<float>& vertices = mesh.vertices;
+    const std::vector<uint32_t>& indices = mesh.indices;
+    const size_t vertex_count = vertices.size() / 3;
+    const bool has_texcoords = vertex_count > 0 && mesh.texcoords.size() == vertex_count * 2;
+    const bool has_normals = vertex_count > 0 && mesh.normals.size() == vertex_count * 3;
+    std::cout << "[Debug] Saving OBJ with " << vertex_count << " vertices and " << indices.size()/3 << " faces." << std::endl;
+    BufferedWriter file(path);
+    if (!file.isOpen()) {
         std::cerr << "Failed to open file for OBJ export: " << path << std::endl;
         return;
     }
 
-    file << "# Quasar-Spatial Recovered Model\n";
-    
-    // Write vertices
-    for (size_t i = 0; i < vertices.size(); i += 3) {
-        file << "v " << vertices[i] << " " << vertices[i+1] << " " << vertices[i+2] << "\n";
-    }
+    static const char kBanner[] = "# Quasar-Spatial Recovered Model\n";
+    file.write(kBanner, sizeof(kBanner) - 1);
 
-    // Write faces (OBJ indices are 1-based)
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        file << "f " << (indices[i] + 1) << " " << (indices[i+1] + 1) << " " << (indices[i+2] + 1) << "\n";
+    // Write vertices (then texcoords and normals, same numbering). glTF puts the uv origin at the
+    // top-left and OBJ at the bottom-left, so texcoords go out as (u, 1 - v).
+    auto writeRows = [&file](const char* tag, const std::vector<float>& values, size_t width, bool flip_v = false) {
+        const size_t tag_length = std::strlen(tag);
+        for (size_t i = 0; i + width <= values.size(); i += width) {
+            char* out = file.reserve(tag_length + width * (kMaxNumberChars + 1) + 1);
+            out = std::copy(tag, tag + tag_length, out);
+            for (size_t c = 0; c < width; ++c) {
+                *out++ = ' ';
+                out = writeNumber(out, flip_v && c == 1 ? 1.0f - values[i + c] : values[i + c]);
+            }
+            *out++ = '\n';
+            file.commit(out);
+        }
+    };
+    writeRows("v", vertices, 3);
+    if (has_texcoords) writeRows("vt", mesh.texcoords, 2, true);
+    if (has_normals) writeRows("vn", mesh.normals, 3);
+
+    // Write faces per primitive (OBJ indices are 1-based; v/vt/vn share the vertex number)
+    const std::vector<PrimitiveRange> ranges = primitiveRanges(mesh);
+    for (size_t p = 0; p < ranges.size(); ++p) {
+        if (ranges.size() > 1) {
+            char* out = file.reserve(kMaxNumberChars + 16);
+            static const char kGroup[] = "g primitive_";
+            out = std::copy(kGroup, kGroup + sizeof(kGroup) - 1, out);
+            out = writeNumber(out, (uint64_t)p);
+            *out++ = '\n';
+            file.commit(out);
+        }
+        const size_t end = std::min<size_t>((size_t)ranges[p].index_first + ranges[p].index_count, indices.size());
+        for (size_t i = ranges[p].index_first; i + 2 < end; i += 3) {
+            char* out = file.reserve(3 * (3 * (kMaxNumberChars + 5) + 3) + 2);
+            *out++ = 'f';
+            for (int c = 0; c < 3; ++c) {
+                const uint64_t number = (uint64_t)indices[i + c] + 1;
+                *out++ = ' ';
+                out = writeNumber(out, number);
+                if (has_texcoords || has_normals) {
+                    *out++ = '/';
+                    if (has_texcoords) out = writeNumber(out, number);
+                    if (has_normals) {
+                        *out++ = '/';
+                        out = writeNumber(out, number);
+                    }
+                }
+            }
+            *out++ = '\n';
+            file.commit(out);
+        }
     }
 
-    file.close();
+    if (!file.close()) {
+        std::cerr << "Failed to write OBJ export: " << path << std::endl;
+        return;
+    }
     std::cout << "[Spatial] Exported to OBJ: " << path << std::endl;
 }
+
+void SpatialPacker::saveAsGLB(const std::string& path, const MeshData& mesh) {
+    const std::vector<float>& vertices = mesh.vertices;
+    const std::vector<uint32_t>& indices = mesh.indices;
+    std::cout << "[Debug] Saving GLB with " << vertices.size()/3 << " vertices and " << indices.size()/3 << " faces." << std::endl;
+    const size_t vertex_count = vertices.size() / 3;
+    const size_t position_bytes = vertex_count * 3 * sizeof(float);
+    const size_t normal_bytes = vertex_count > 0 && mesh.normals.size() == vertex_count * 3 ? position_bytes : 0;
+    const size_t texcoord_bytes = vertex_count > 0 && mesh.texcoords.size() == vertex_count * 2 ? vertex_count * 2 * sizeof(float) : 0;
+    const size_t index_bytes = indices.size() * sizeof(uint32_t);
+    const size_t attribute_bytes = position_bytes + normal_bytes + texcoord_bytes;
+
+    // glTF forbids zero-length buffers, views and accessors
+    if (vertex_count == 0) {
+        std::cerr << "Refusing to export an empty mesh to GLB: " << path << std::endl;
+        return;
+    }
+
+    // 1. POSITION accessors require min/max; JSON has no nan/inf, so non-finite values are skipped
+    float lo[3] = {0.0f, 0.0f, 0.0f}, hi[3] = {0.0f, 0.0f, 0.0f};
+    bool seen[3] = {false, false, false};
+    for (size_t v = 0; v < vertex_count; ++v) {
+        for (int c = 0; c < 3; ++c) {
+            const float value = vertices[v * 3 + c];
+            if (!std::isfinite(value)) continue;
+            lo[c] = seen[c] ? std::min(lo[c], value) : value;
+            hi[c] = seen[c] ? std::max(hi[c], value) : value;
+            seen[c] = true;
+        }
+    }
+    auto vec3 = [](const float* xyz) {
+        char text[3 * (kMaxNumberChars + 1) + 2];
+        char* out = text;
+        *out++ = '[';
+        for (int c = 0; c < 3; ++c) {
+            if (c) *out++ = ',';
+            out = writeNumber(out, xyz[c]);
+        }
+        *out++ = ']';
+        return std::string(text, out);
+    };
+
+    // 2. JSON chunk: one buffer with positions, normals, texcoords, then indices; one view and
+    //    accessor per attribute, one index accessor per primitive
+    std::string views, accessors, attributes = "\"POSITION\":0";
+    size_t offset = 0;
+    int view = 0;
+    auto addView = [&](size_t bytes, int target) {
+        if (view) views += ",";
+        views += "{\"buffer\":0,\"byteOffset\":" + std::to_string(offset) + ",\"byteLength\":" + std::to_string(bytes) +
+                 ",\"target\":" + std::to_string(target) + "}";
+        offset += bytes;
+        return view++;
+    };
+    accessors = "{\"bufferView\":" + std::to_string(addView(position_bytes, 34962)) + ",\"componentType\":5126,\"count\":" +
+                std::to_string(vertex_count) + ",\"type\":\"VEC3\",\"min\":" + vec3(lo) + ",\"max\":" + vec3(hi) + "}";
+    int accessor = 1;
+    if (normal_bytes > 0) {
+        accessors += ",{\"bufferView\":" + std::to_string(addView(normal_bytes, 34962)) + ",\"componentType\":5126,\"count\":" +
+                     std::to_string(vertex_count) + ",\"type\":\"VEC3\"}";
+        attributes += ",\"NORMAL\":" + std::to_string(accessor++);
+    }
+    if (texcoord_bytes > 0) {
+        accessors += ",{\"bufferView\":" + std::to_string(addView(texcoord_bytes, 34962)) + ",\"componentType\":5126,\"count\":" +
+                     std::to_string(vertex_count) + ",\"type\":\"VEC2\"}";
+        attributes += ",\"TEXCOORD_0\":" + std::to_string(accessor++);
+    }
+    std::string primitives;
+    if (index_bytes > 0) {
+        const int index_view = addView(index_bytes, 34963);
+        const std::vector<PrimitiveRange> ranges = primitiveRanges(mesh);
+        for (size_t p = 0; p < ranges.size(); ++p) {
+            if (ranges[p].index_count == 0) continue;
+            accessors += ",{\"bufferView\":" + std::to_string(index_view) + ",\"byteOffset\":" +
+                         std::to_string((size_t)ranges[p].index_first * sizeof(uint32_t)) + ",\"componentType\":5125,\"count\":" +
+                         std::to_string(ranges[p].index_count) + ",\"type\":\"SCALAR\"}";
+            if (!primitives.empty()) primitives += ",";
+            primitives += "{\"attributes\":{" + attributes + "},\"indices\":" + std::to_string(accessor++) + ",\"mode\":4}";
+        }
+    }
+    if (primitives.empty()) primitives = "{\"attributes\":{" + attributes + "},\"mode\":4}";
+    std::string json = "{\"asset\":{\"version\":\"2.0\",\"generator\":\"quasar-spatial\"},\"scene\":0,"
+        "\"scenes\":[{\"nodes\":[0]}],\"nodes\":[{\"mesh\":0}],"
+        "\"buffers\":[{\"byteLength\":" + std::to_string(attribute_bytes + index_bytes) + "}],"
+        "\"bufferViews\":[" + views + "],\"accessors\":[" + accessors + "],\"meshes\":[{\"primitives\":[" + primitives + "]}]}";
+
+    // 3. Container: 12-byte header, JSON chunk (space padded), BIN chunk (zero padded)
+    const uint32_t json_length = (uint32_t)((json.size() + 3) & ~(size_t)3);
+    const uint32_t bin_length = (uint32_t)((attribute_bytes + index_bytes + 3) & ~(size_t)3);
+    const uint32_t glb_header[3] = {0x46546C67, 2, 12 + 8 + json_length + 8 + bin_length};
+    const uint32_t json_header[2] = {json_length, 0x4E4F534A};
+    const uint32_t bin_header[2] = {bin_length, 0x004E4942};
+
+    BufferedWriter file(path);
+    if (!file.isOpen()) {
+        std::cerr << "Failed to open file for GLB export: " << path << std::endl;
+        return;
+    }
+    file.write(glb_header, sizeof(glb_header));
+    file.write(json_header, sizeof(json_header));
+    file.write(json.data(), json.size());
+    file.pad(json_length - json.size(), ' ');
+    file.write(bin_header, sizeof(bin_header));
+    file.write(vertices.data(), position_bytes);
+    file.write(mesh.normals.data(), normal_bytes);
+    file.write(mesh.texcoords.data(), texcoord_bytes);
+    file.write(indices.data(), index_bytes);
+    file.pad(bin_length - attribute_bytes - index_bytes, 0);
+
+    if (!file.close()) {
+        std::cerr << "Failed to write GLB export: " << path << std::endl;
+        return;
+    }
+    std::cout << "[Spatial] Exported to GLB: " << path << std::endl;
+}
+
+void SpatialPacker::saveAsBlob(const std::string& path, const MeshData& mesh) {
+    const std::vector<float>& vertices = mesh.vertices;
+    const std::vector<uint32_t>& indices = mesh.indices;
+    std::cout << "[Debug] Saving blob with " << vertices.size()/3 << " vertices and " << indices.size()/3 << " faces." << std::endl;
+    auto align64 = [](uint64_t offset) { return (offset + 63) & ~(uint64_t)63; };
+
+    MeshBlobHeader header = {};
+    std::memcpy(header.magic, "QSMB", 4);
+    header.version = 1;
+    header.vertex_count = vertices.size() / 3;
+    header.index_count = indices.size();
+    header.vertex_offset = align64(sizeof(MeshBlobHeader));
+    header.index_offset = align64(header.vertex_offset + header.vertex_count * 3 * sizeof(float));
+
+    BufferedWriter file(path);
+    if (!file.isOpen()) {
+        std::cerr << "Failed to open file for blob export: " << path << std::endl;
+        return;
+    }
+    file.write(&header, sizeof(header));
+    file.pad(header.vertex_offset - sizeof(header), 0);
+    file.write(vertices.data(), header.vertex_count * 3 * sizeof(float));
+    file.pad(header.index_offset - header.vertex_offset - header.vertex_count * 3 * sizeof(float), 0);
+    file.write(indices.data(), header.index_count * sizeof(uint32_t));
+
+    if (!file.close()) {
+        std::cerr << "Failed to write blob export: " << path << std::endl;
+        return;
+    }
+    std::cout << "[Spatial] Exported to blob: " << path << std::endl;
+}
+
+void SpatialPacker::saveMesh(const std::string& stem, ExportFormat format, const MeshData& mesh) {
+    if (mesh.vertices.size() < 3) {
+        std::cerr << "[Spatial] Refusing to export an empty mesh: " << stem << std::endl;
+        return;
+    }
+    switch (format) {
+        case ExportFormat::GLB: saveAsGLB(stem + ".glb", mesh); break;
+        case ExportFormat::Blob: saveAsBlob(stem + ".qsmb", mesh); break;
+        default: saveAsOBJ(stem + ".obj", mesh); break;
+    }
+}
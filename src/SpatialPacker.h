@@ -5,6 +5,7 @@
 #include <string>
 #include <iostream>
 #include <cstdint>
+#include <array>
 
 /**
  * Accessor Stride Aura Check:
@@ -16,9 +17,20 @@
  * for each iteration to jump to the next vertex reliably.
  */
 
+// Contiguous slice of a component that came from one glTF primitive
+struct PrimitiveRange {
+    uint32_t vertex_first = 0;
+    uint32_t vertex_count = 0;
+    uint32_t index_first = 0;
+    uint32_t index_count = 0;
+};
+
 struct MeshData {
     std::vector<float> vertices;
-    std::vector<uint32_t> indices;
+    std::vector<uint32_t> indices;          // Component-wide: each primitive's indices are offset by its vertex_first
+    std::vector<PrimitiveRange> primitives; // Empty means one primitive covering everything
+    std::vector<float> normals;             // xyz per vertex, or empty
+    std::vector<float> texcoords;           // uv per vertex (TEXCOORD_0), or empty
     std::string name;
 };
 
@@ -28,8 +40,45 @@ struct MeshData {
  * - uint32_t Indices: We promote all indices to 32-bit to ensure internal pipeline uniformity 
  *   and safety. Large Martian terrains or robotic models can easily exceed the 64k limit 
  *   of uint16_t; using uint32_t prevents parity errors and overflow during decompression.
+ * - Primitives: a node's primitives are concatenated into one component, with each
+ *   primitive's indices offset by the vertices already extracted and its slice recorded in
+ *   MeshData::primitives. Reordering (optimizeTopology, reorderSpatially) stays inside each
+ *   slice, so the ranges survive all the way to the receiver.
+ * - Attributes: NORMAL and TEXCOORD_0 are extracted when any primitive has them (zero-filled
+ *   for primitives that do not) and follow every vertex permutation.
+ */
+
+/**
+ * Export Aura Check:
+ * Multi-million-vertex terrain took longer to write than to decode through ofstream <<, which
+ * also rounds every float to 6 significant digits. All exporters now go through one large
+ * write buffer, and OBJ numbers use std::to_chars (shortest round-trip, locale-free), so the
+ * text file reproduces the decoded floats bit for bit. Each export is written to "<path>.tmp"
+ * and renamed into place, so a viewer reloading the file never reads a partial one, and empty
+ * meshes are not written at all.
+ * - OBJ and GLB carry normals and texcoords when the component has them, and keep each
+ *   primitive separate (an OBJ group / a glTF primitive over its index range).
+ * - GLB: a single-mesh glTF 2.0 binary (POSITION + uint32 indices) any glTF tool can open.
+ *   POSITION min/max skip non-finite values, which JSON cannot represent.
+ * - Blob: MeshBlobHeader followed by the raw vertex and index arrays at 64-byte aligned
+ *   offsets, so a downstream tool can mmap the file and use the arrays in place. Positions
+ *   and indices only.
  */
 
+enum class ExportFormat { OBJ, GLB, Blob };
+
+// Saliency thresholds for the X, Y and Z coefficient planes
+using PlaneThresholds = std::array<float, 3>;
+
+struct MeshBlobHeader {
+    char magic[4];          // "QSMB"
+    uint32_t version;       // 1
+    uint64_t vertex_count;  // xyz float triples
+    uint64_t index_count;   // uint32 indices
+    uint64_t vertex_offset; // Byte offset of the float array
+    uint64_t index_offset;  // Byte offset of the index array
+};
+
 class SpatialPacker {
 public:
     SpatialPacker() = default;
@@ -37,14 +86,49 @@ public:
     // Loads a GLB file and extracts full MeshData for all components
     std::vector<MeshData> extractMeshData(const char* path);
 
-    // Applies Haar wavelet transform and threshold-based saliency filtering (Vertices only)
-    void compressMesh(std::vector<float>& vertices, float threshold);
+    // Applies a `levels`-deep Haar wavelet transform and threshold-based saliency filtering (Vertices only)
+    void compressMesh(std::vector<float>& vertices, float threshold, int levels = 1);
+
+    // The two halves of compressMesh, for callers that pick thresholds after seeing the coefficients
+    void transformMesh(std::vector<float>& vertices, int levels = 1);
+    static void applyThresholds(std::vector<float>& coefficients, const PlaneThresholds& thresholds);
+
+    // The component's primitive slices, or one slice covering it when none are recorded
+    static std::vector<PrimitiveRange> primitiveRanges(const MeshData& mesh);
+
+    // Reorders triangles for vertex cache locality (Forsyth), then renumbers vertices in first-use
+    // order, per primitive. Winding is preserved; must run before compressMesh since it permutes vertices.
+    void optimizeTopology(MeshData& mesh);
+
+    // Sorts each primitive's vertices along a Morton curve over its quantized bounding box and remaps indices to
+    // match, so the wavelet sees spatial neighbours side by side. Must run before compressMesh.
+    void reorderSpatially(MeshData& mesh);
+
+    // The permutation reorderSpatially applies (vertex v moves to slot remap[v]); empty when the
+    // mesh is left as is. Session mode keeps it per target so moving parts keep one vertex order.
+    static std::vector<uint32_t> spatialOrder(const MeshData& mesh);
+
+    // Moves vertex v (and its attributes) to slot remap[v] and rewrites indices accordingly
+    static void applyVertexRemap(MeshData& mesh, const std::vector<uint32_t>& remap);
+
+    // Inverse Haar transform (same depth as compressMesh) to restore vertices
+    void decompressMesh(std::vector<float>& vertices, int levels = 1);
+
+    // Exports recovered mesh data to a standard OBJ file (vt/vn when present, one group per primitive)
+    static void saveAsOBJ(const std::string& path, const MeshData& mesh);
+
+    // Exports recovered mesh data as a glTF 2.0 binary (NORMAL/TEXCOORD_0 when present, one glTF primitive per primitive)
+    static void saveAsGLB(const std::string& path, const MeshData& mesh);
+
+    // Exports recovered positions and indices as an mmap-able MeshBlobHeader + raw arrays file
+    static void saveAsBlob(const std::string& path, const MeshData& mesh);
 
-    // Inverse Planar Haar transform to restore vertices
-    void decompressMesh(std::vector<float>& vertices);
+    // Exports to `stem` plus the extension of `format` (.obj, .glb or .qsmb)
+    static void saveMesh(const std::string& stem, ExportFormat format, const MeshData& mesh);
 
-    // Exports recovered mesh data to a standard OBJ file
-    static void saveAsOBJ(const std::string& path, const std::vector<float>& vertices, const std::vector<uint32_t>& indices);
+private:
+    // Detail-band scratch reused across calls so the transform allocates only on growth
+    std::vector<float> scratch_;
 };
 
 #endif // SPATIAL_PACKER_H
@@ -0,0 +1,62 @@
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+/**
+ * SPSC Ring Aura Check:
+ * Exactly one producer thread calls tryPush and exactly one consumer thread calls tryPop.
+ * head_ is only written by the consumer and tail_ only by the producer, so no CAS is needed:
+ * the producer publishes a filled slot with a release store of tail_, and the consumer hands
+ * the slot back with a release store of head_. Each side keeps a cached copy of the other's
+ * index and only reloads it when the ring looks full (or empty), which keeps the shared cache
+ * lines quiet in the common case. Capacity is rounded up to a power of two.
+ */
+
+template <typename T>
+class SpscRing {
+public:
+    explicit SpscRing(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    // Producer only; returns false (leaving value untouched) when the ring is full
+    bool tryPush(T&& value) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cached_head_ > mask_) {
+            cached_head_ = head_.load(std::memory_order_acquire);
+            if (tail - cached_head_ > mask_) return false;
+        }
+        slots_[tail & mask_] = std::move(value);
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only; returns false when the ring is empty
+    bool tryPop(T& value) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cached_tail_) {
+            cached_tail_ = tail_.load(std::memory_order_acquire);
+            if (head == cached_tail_) return false;
+        }
+        value = std::move(slots_[head & mask_]);
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> slots_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_{0};
+    size_t cached_tail_ = 0; // Consumer's view of tail_
+    alignas(64) std::atomic<size_t> tail_{0};
+    size_t cached_head_ = 0; // Producer's view of head_
+};
+
+#endif // SPSC_RING_H
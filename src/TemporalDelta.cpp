@@ -0,0 +1,105 @@
+#include "TemporalDelta.h"
+#include "ByteStream.h"
+#include "CoefficientCodec.h"
+#include "RateControl.h"
+#include <cmath>
+
+uint64_t topologyHash(const std::vector<uint32_t>& indices, size_t float_count) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    auto mix = [&hash](uint32_t value) {
+        for (int b = 0; b < 4; ++b) {
+            hash ^= (value >> (b * 8)) & 0xFF;
+            hash *= 0x100000001B3ull;
+        }
+    };
+    mix((uint32_t)float_count);
+    for (uint32_t idx : indices) mix(idx);
+    return hash;
+}
+
+DeltaSessions::Entry& DeltaSessions::entry(uint32_t target_id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return entries_[target_id];
+}
+
+std::vector<uint8_t> DeltaSessions::encodeDelta(Entry& entry, const std::vector<float>& coefficients, uint64_t source_hash,
+                                                const PlaneThresholds& thresholds, float max_error, int bits, int levels) {
+    if (!entry.valid || entry.source_hash != source_hash || entry.reference.size() != coefficients.size() ||
+        entry.sequence + 1 >= (uint32_t)keyframe_interval_) {
+        return {};
+    }
+
+    // 1. Residual against what the receiver holds, with a dead zone: the saliency threshold, or
+    //    one searched on the residual itself under rate control
+    std::vector<float> residual(coefficients.size());
+    for (size_t i = 0; i < coefficients.size(); ++i) residual[i] = coefficients[i] - entry.reference[i];
+    const PlaneThresholds dead_zone = max_error > 0.0f ? RateControl::allocateResidual(residual, levels, bits, max_error) : thresholds;
+    SpatialPacker::applyThresholds(residual, dead_zone);
+    std::vector<uint8_t> stream = CoefficientCodec::encode(residual, bits, levels);
+
+    // 2. Close the loop: advance the reference by exactly what the receiver will decode
+    std::vector<float> applied;
+    int depth = 0;
+    if (!CoefficientCodec::decode(stream, applied, depth, entry.reference.size() / 3) || applied.size() != entry.reference.size()) return {};
+    for (size_t i = 0; i < applied.size(); ++i) entry.reference[i] += applied[i];
+    ++entry.sequence;
+
+    std::vector<uint8_t> payload;
+    payload.reserve(sizeof(uint64_t) + 2 * sizeof(uint32_t) + stream.size());
+    writeRaw(payload, entry.wire_hash);
+    writeRaw(payload, entry.epoch);
+    writeRaw(payload, entry.sequence);
+    payload.insert(payload.end(), stream.begin(), stream.end());
+    return payload;
+}
+
+void DeltaSessions::recordKeyframe(Entry& entry, uint64_t source_hash, uint64_t wire_hash, const std::vector<float>& coefficients, int bits) {
+    float steps[3];
+    CoefficientCodec::planeSteps(coefficients.data(), coefficients.size(), bits, steps);
+    entry.reference.resize(coefficients.size());
+    CoefficientCodec::roundTrip(coefficients.data(), coefficients.size(), steps, entry.reference.data());
+    entry.valid = true;
+    entry.source_hash = source_hash;
+    entry.wire_hash = wire_hash;
+    entry.epoch = entry.epoch == UINT32_MAX ? 1 : entry.epoch + 1;
+    entry.sequence = 0;
+}
+
+void DeltaReceiver::keyframe(uint32_t target_id, int levels, uint32_t epoch, const MeshData& mesh) {
+    Session& session = sessions_[target_id];
+    session.levels = levels;
+    session.epoch = epoch;
+    session.hash = topologyHash(mesh.indices, mesh.vertices.size());
+    session.sequence = 0;
+    session.mesh = mesh;
+}
+
+bool DeltaReceiver::apply(uint32_t target_id, size_t float_count, const uint8_t* payload, size_t size) {
+    auto it = sessions_.find(target_id);
+    if (it == sessions_.end() || it->second.mesh.vertices.size() != float_count) return false;
+    Session& session = it->second;
+
+    ByteReader reader(payload, size);
+    uint64_t hash = 0;
+    uint32_t epoch = 0, sequence = 0;
+    if (!reader.readRaw(hash) || !reader.readRaw(epoch) || !reader.readRaw(sequence)) return false;
+    if (hash != session.hash || epoch == 0 || epoch != session.epoch || sequence != session.sequence + 1) return false;
+
+    std::vector<uint8_t> stream(reader.ptr, reader.end);
+    std::vector<float> residual;
+    int levels = 0;
+    if (!CoefficientCodec::decode(stream, residual, levels, float_count / 3) || residual.size() != float_count) return false;
+
+    for (size_t i = 0; i < residual.size(); ++i) session.mesh.vertices[i] += residual[i];
+    session.sequence = sequence;
+    return true;
+}
+
+bool DeltaReceiver::reconstruct(uint32_t target_id, SpatialPacker& packer, MeshData& mesh) const {
+    auto it = sessions_.find(target_id);
+    if (it == sessions_.end()) return false;
+
+    mesh = it->second.mesh;
+    packer.decompressMesh(mesh.vertices, it->second.levels);
+    return true;
+}
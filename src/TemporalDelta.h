@@ -0,0 +1,104 @@
+#ifndef TEMPORAL_DELTA_H
+#define TEMPORAL_DELTA_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include "SpatialPacker.h"
+
+/**
+ * Temporal Delta Aura Check:
+ * Live telemetry resends the same component many times while only a few joints move. In
+ * session mode (--stream) the first frame for a target_id is a keyframe (file_type 0x03 with
+ * flag 0x40); the receiver caches its decoded coefficients and topology. Later passes with the
+ * same topology send only file_type 0x05 frames holding the coefficient residual, which the
+ * receiver adds onto its cache. Topology and attributes (normals, UVs) are not resent at all.
+ * - Vertex order: --reorder morton sorts by position, so a moving part would get a new
+ *   permutation, new indices and a forced keyframe every pass. The permutation is instead kept
+ *   per target while the source topology (hashed before reordering) is unchanged.
+ * - Closed loop: the TX keeps exactly what the receiver holds (it decodes its own stream), so
+ *   quantization error never accumulates; the next residual simply corrects it.
+ * - The saliency threshold is a dead zone on the residual, so a static part costs a few bytes
+ *   of zero runs per pass. Under rate control the dead zone is instead searched on the residual
+ *   itself (RateControl::allocateResidual), so every delta stays within the error bound.
+ * - QuasarHeader has no spare field, so the topology hash travels in the delta payload. With
+ *   no ack channel, every keyframe carries an epoch (its Session section) and every delta
+ *   names that epoch plus a sequence number: the receiver rejects a delta for another keyframe
+ *   or one that does not follow the last one it applied, and waits for the next keyframe,
+ *   which the TX forces every keyframe_interval frames and whenever the topology hash changes.
+ *   Without the epoch, a delta for a lost keyframe with unchanged topology would apply cleanly
+ *   onto the previous keyframe's coefficients.
+ * Delta frame payload: [u64 topology hash][u32 epoch][u32 sequence][coefficient stream of the residual]
+ */
+
+constexpr uint8_t kFileTypeSpatialDelta = 0x05;
+constexpr uint8_t kFlagSessionKeyframe = 0x40;
+
+// FNV-1a over the index list and the vertex float count
+uint64_t topologyHash(const std::vector<uint32_t>& indices, size_t float_count);
+
+// TX side: what the receiver holds for each target_id after the last frame sent
+class DeltaSessions {
+public:
+    struct Entry {
+        bool valid = false;
+        uint64_t source_hash = 0;     // Source indices before any reordering, to spot topology changes
+        uint64_t wire_hash = 0;       // Indices as the receiver decodes them
+        uint32_t epoch = 0;           // Keyframes sent for this target; 0 before the first
+        uint32_t sequence = 0;        // Deltas sent since the keyframe
+        std::vector<float> reference; // Receiver's dequantized coefficients
+        uint64_t order_hash = 0;      // Source topology vertex_order was computed for
+        std::vector<uint32_t> vertex_order; // Morton permutation, fixed while the topology is unchanged
+    };
+
+    explicit DeltaSessions(int keyframe_interval) : keyframe_interval_(keyframe_interval < 1 ? 1 : keyframe_interval) {}
+
+    // Stable reference to the target's entry, created on first use. Workers may call this
+    // concurrently as long as each target_id is packed by one worker at a time.
+    Entry& entry(uint32_t target_id);
+
+    // Residual against the receiver's cache as a delta payload, advancing the entry; returns an
+    // empty vector when a keyframe is due instead. With max_error > 0 the dead zone comes from
+    // RateControl::allocateResidual and `thresholds` is unused.
+    std::vector<uint8_t> encodeDelta(Entry& entry, const std::vector<float>& coefficients, uint64_t source_hash,
+                                     const PlaneThresholds& thresholds, float max_error, int bits, int levels);
+
+    // Records a keyframe and starts a new epoch: the receiver will hold `coefficients` as
+    // quantized to `bits`
+    void recordKeyframe(Entry& entry, uint64_t source_hash, uint64_t wire_hash, const std::vector<float>& coefficients, int bits);
+
+private:
+    std::mutex mutex_;
+    std::map<uint32_t, Entry> entries_;
+    int keyframe_interval_;
+};
+
+// RX side: cached coefficients per target_id that delta frames apply to
+class DeltaReceiver {
+public:
+    // Caches a session keyframe of `epoch`: mesh.vertices holds the decoded (pre-inverse)
+    // coefficients, alongside its topology and attributes
+    void keyframe(uint32_t target_id, int levels, uint32_t epoch, const MeshData& mesh);
+
+    // Applies a delta frame payload. Returns false without touching the cache when there is no
+    // keyframe, the topology hash or epoch differs, a delta was missed, or the payload is malformed
+    bool apply(uint32_t target_id, size_t float_count, const uint8_t* payload, size_t size);
+
+    // Inverse-transforms the cached coefficients into `mesh`; returns false for unknown targets
+    bool reconstruct(uint32_t target_id, SpatialPacker& packer, MeshData& mesh) const;
+
+private:
+    struct Session {
+        int levels = 1;
+        uint64_t hash = 0;
+        uint32_t epoch = 0;
+        uint32_t sequence = 0;
+        MeshData mesh; // vertices hold coefficients
+    };
+
+    std::map<uint32_t, Session> sessions_;
+};
+
+#endif // TEMPORAL_DELTA_H
@@ -0,0 +1,228 @@
+#include "TxPipeline.h"
+#include "SpatialFrame.h"
+#include "HaarTransform.h"
+#include "../lib/quasar_core/quasar_format.h"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <iostream>
+#include <thread>
+
+namespace {
+QuasarHeader makeHeader(uint8_t file_type, uint8_t flags, size_t original_size, uint32_t target_id, size_t float_count) {
+    QuasarHeader header = {};
+    std::memcpy(header.magic, "QSR1", 4);
+    header.file_type = file_type;
+    header.original_size = (uint32_t)std::min<size_t>(original_size, UINT32_MAX); // Saturates: RX bounds vertex counts by it
+    header.compression_flags = flags;
+    header.scale = 1.0f;
+    header.target_id = target_id;
+    header.width = (uint32_t)float_count; // Band and delta frames are checked against it; sectioned payloads carry their own layout
+    return header;
+}
+} // namespace
+
+uint64_t orderComponent(SpatialPacker& packer, MeshData& component, const TxSettings& settings, DeltaSessions::Entry* session) {
+    const uint64_t source_hash = topologyHash(component.indices, component.vertices.size());
+    if (!settings.morton_order) {
+        packer.optimizeTopology(component); // Depends on topology alone: stable across passes
+    } else if (!session) {
+        packer.reorderSpatially(component);
+    } else {
+        // Morton codes follow positions: fix the permutation per source topology, not per pass
+        if (session->order_hash != source_hash || session->vertex_order.size() != component.vertices.size() / 3) {
+            session->vertex_order = SpatialPacker::spatialOrder(component);
+            session->order_hash = source_hash;
+        }
+        if (!session->vertex_order.empty()) SpatialPacker::applyVertexRemap(component, session->vertex_order);
+    }
+    return source_hash;
+}
+
+uint64_t prepareComponent(SpatialPacker& packer, MeshData& component, const TxSettings& settings, DeltaSessions::Entry* session) {
+    const uint64_t source_hash = orderComponent(packer, component, settings, session);
+    packer.transformMesh(component.vertices, settings.levels);
+    return source_hash;
+}
+
+std::vector<uint64_t> prepareScene(std::vector<MeshData>& components, const TxSettings& settings, int jobs, DeltaSessions* sessions) {
+    std::vector<uint64_t> source_hashes(components.size(), 0);
+    std::atomic<size_t> next_component{0};
+    std::vector<std::thread> workers;
+    for (int w = 0; w < std::max(jobs, 1); ++w) {
+        workers.emplace_back([&] {
+            SpatialPacker packer;
+            for (size_t i = next_component++; i < components.size(); i = next_component++) {
+                DeltaSessions::Entry* session = sessions ? &sessions->entry((uint32_t)i) : nullptr;
+                source_hashes[i] = prepareComponent(packer, components[i], settings, session);
+            }
+        });
+    }
+    for (std::thread& worker : workers) worker.join();
+    return source_hashes;
+}
+
+FrameList packComponent(SpatialPacker& packer, MeshData& component, uint32_t target_id, const TxSettings& settings,
+                        DeltaSessions* sessions) {
+    std::cout << "\nProcessing Component [" << target_id << "]: " << component.name << std::endl;
+
+    const size_t original_size = (component.vertices.size() + component.normals.size() + component.texcoords.size()) * sizeof(float) +
+                                 component.indices.size() * sizeof(uint32_t);
+    const bool rate_controlled = target_id < settings.plane_thresholds.size();
+    const PlaneThresholds thresholds = rate_controlled ? settings.plane_thresholds[target_id]
+                                                       : PlaneThresholds{settings.threshold, settings.threshold, settings.threshold};
+    DeltaSessions::Entry* session = sessions ? &sessions->entry(target_id) : nullptr;
+    uint64_t source_hash = 0;
+    if (rate_controlled) {
+        // Ordered + transformed in the scene pre-pass, which hashed the source topology
+        source_hash = target_id < settings.source_hashes.size() ? settings.source_hashes[target_id] : 0;
+    } else {
+        // --- TOPOLOGY ORDER (cache-ordered triangles + first-use vertices, or Morton-ordered vertices) ---
+        source_hash = orderComponent(packer, component, settings, session);
+
+        // --- VERTEX PATH (Signal Logic) ---
+        packer.compressMesh(component.vertices, settings.threshold, settings.levels);
+    }
+
+    // --- TEMPORAL DELTA (session mode): residual only, no topology ---
+    if (session) {
+        // Under rate control the residual gets its own dead zone, searched against the error bound
+        std::vector<uint8_t> delta = sessions->encodeDelta(*session, component.vertices, source_hash, thresholds,
+                                                           rate_controlled ? settings.delta_max_error : 0.0f,
+                                                           settings.coefficient_bits, settings.levels);
+        if (!delta.empty()) {
+            QuasarHeader header = makeHeader(kFileTypeSpatialDelta, 0x0D, original_size,
+                                             target_id, component.vertices.size());
+            FrameList frames(1, std::vector<uint8_t>(sizeof(QuasarHeader) + delta.size()));
+            std::memcpy(frames[0].data(), &header, sizeof(QuasarHeader));
+            std::memcpy(frames[0].data() + sizeof(QuasarHeader), delta.data(), delta.size());
+            std::cout << "[Spatial] Delta frame (epoch " << session->epoch << ", sequence " << session->sequence << "): " << delta.size() << " bytes." << std::endl;
+            return frames;
+        }
+    }
+
+    if (rate_controlled) {
+        // --- VERTEX PATH (rate-controlled): ordered + transformed in the scene pre-pass ---
+        SpatialPacker::applyThresholds(component.vertices, thresholds);
+        std::cout << "[Spatial] Rate-controlled thresholds: (" << thresholds[0] << ", " << thresholds[1] << ", "
+                  << thresholds[2] << ")." << std::endl;
+    }
+
+    const bool progressive = settings.progressive && !sessions;
+    const std::vector<size_t> bands = progressive
+        ? haarBandSizes(component.vertices.size() / 3, settings.levels)
+        : std::vector<size_t>{component.vertices.size() / 3};
+    auto encodeBand = [&](size_t first, size_t count) {
+        return CoefficientCodec::encode(component.vertices.data() + first * 3, count * 3, settings.coefficient_bits, settings.levels);
+    };
+
+    // --- SECTIONED PAYLOAD: layout, positions (first band), topology, attributes ---
+    std::vector<uint8_t> payload = SpatialFrame::encode(component, bands[0] * 3, settings.coefficient_bits, settings.levels);
+    if (session) {
+        sessions->recordKeyframe(*session, source_hash, topologyHash(component.indices, component.vertices.size()),
+                                 component.vertices, settings.coefficient_bits);
+        SpatialFrame::appendSession(payload, session->epoch);
+    }
+
+    // --- THE QUASAR BRIDGE ---
+    // Wavelet + Quantized + Sectioned (+ Progressive base / Session keyframe); codecs are named per section
+    const uint8_t flags = 0x05 | kFlagSectioned | (progressive ? kFlagProgressive : 0) | (session ? kFlagSessionKeyframe : 0);
+    QuasarHeader header = makeHeader(kFileTypeSpatial, flags, original_size, target_id, component.vertices.size());
+
+    FrameList frames(1, std::vector<uint8_t>(sizeof(QuasarHeader) + payload.size()));
+    std::memcpy(frames[0].data(), &header, sizeof(QuasarHeader));
+    std::memcpy(frames[0].data() + sizeof(QuasarHeader), payload.data(), payload.size());
+
+    // --- DETAIL BANDS (progressive only): [u8 band][coefficient stream] per frame ---
+    size_t first = bands[0];
+    for (size_t b = 1; b < bands.size(); ++b) {
+        std::vector<uint8_t> band_stream = encodeBand(first, bands[b]);
+        QuasarHeader band_header = makeHeader(kFileTypeDetailBand, 0x0D, bands[b] * 3 * sizeof(float),
+                                              target_id, component.vertices.size());
+
+        std::vector<uint8_t> frame(sizeof(QuasarHeader) + 1 + band_stream.size());
+        std::memcpy(frame.data(), &band_header, sizeof(QuasarHeader));
+        frame[sizeof(QuasarHeader)] = (uint8_t)b;
+        std::memcpy(frame.data() + sizeof(QuasarHeader) + 1, band_stream.data(), band_stream.size());
+        frames.push_back(std::move(frame));
+        first += bands[b];
+    }
+
+    return frames;
+}
+
+void ProgressiveDispatcher::dispatch(FrameList&& frames) {
+    if (frames.empty()) return;
+    std::cout << "Transmitting component payload: " << frames[0].size() << " bytes." << std::endl;
+    send_(frames[0]);
+
+    if (frames.size() < 2) return;
+    if (deferred_.size() < frames.size() - 1) deferred_.resize(frames.size() - 1);
+    for (size_t b = 1; b < frames.size(); ++b) deferred_[b - 1].push_back(std::move(frames[b]));
+    if (++held_ >= window_) flush();
+}
+
+void ProgressiveDispatcher::flush() {
+    for (size_t b = 0; b < deferred_.size(); ++b) {
+        size_t band_bytes = 0;
+        for (const std::vector<uint8_t>& frame : deferred_[b]) band_bytes += frame.size();
+        std::cout << "Transmitting detail band " << b + 1 << ": " << deferred_[b].size() << " frame(s), "
+                  << band_bytes << " bytes." << std::endl;
+        for (const std::vector<uint8_t>& frame : deferred_[b]) send_(frame);
+    }
+    deferred_.clear();
+    held_ = 0;
+}
+
+OrderedPacketQueue::OrderedPacketQueue(size_t capacity)
+    : slots_(std::max<size_t>(capacity, 1)), filled_(std::max<size_t>(capacity, 1), false) {}
+
+void OrderedPacketQueue::push(size_t seq, FrameList&& packet) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    space_.wait(lock, [&] { return seq < next_ + slots_.size(); });
+    slots_[seq % slots_.size()] = std::move(packet);
+    filled_[seq % slots_.size()] = true;
+    ready_.notify_all();
+}
+
+FrameList OrderedPacketQueue::pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    const size_t slot = next_ % slots_.size();
+    ready_.wait(lock, [&] { return filled_[slot]; });
+    FrameList packet = std::move(slots_[slot]);
+    filled_[slot] = false;
+    ++next_;
+    space_.notify_all();
+    return packet;
+}
+
+TxPipeline::TxPipeline(const TxSettings& settings, int jobs, size_t queue_depth, DeltaSessions* sessions)
+    : settings_(settings), jobs_(std::max(jobs, 1)), queue_depth_(std::max<size_t>(queue_depth, 1)), sessions_(sessions) {}
+
+void TxPipeline::run(std::vector<MeshData>& components, const SendFn& send) {
+    OrderedPacketQueue queue(queue_depth_);
+    std::atomic<size_t> next_component{0};
+
+    // 1. Dedicated sender: drains packets strictly in target_id order; detail bands follow each window
+    std::thread sender([&] {
+        ProgressiveDispatcher dispatcher(send);
+        for (size_t i = 0; i < components.size(); ++i) dispatcher.dispatch(queue.pop());
+        dispatcher.flush();
+    });
+
+    // 2. Workers: each claims the next component, compresses it with its own packer, then enqueues
+    std::vector<std::thread> workers;
+    workers.reserve(jobs_);
+    for (int w = 0; w < jobs_; ++w) {
+        workers.emplace_back([&] {
+            SpatialPacker packer;
+            for (size_t i = next_component++; i < components.size(); i = next_component++) {
+                FrameList packet = packComponent(packer, components[i], (uint32_t)i, settings_, sessions_);
+                queue.push(i, std::move(packet));
+            }
+        });
+    }
+
+    for (std::thread& worker : workers) worker.join();
+    sender.join();
+}
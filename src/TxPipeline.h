@@ -0,0 +1,137 @@
+#ifndef TX_PIPELINE_H
+#define TX_PIPELINE_H
+
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <condition_variable>
+#include "SpatialPacker.h"
+#include "CoefficientCodec.h"
+#include "TemporalDelta.h"
+
+/**
+ * Pipelined TX Aura Check:
+ * Compression is CPU-bound and send_frame is socket-bound, so running them back to back leaves
+ * one side idle. With --jobs N, N workers each own a SpatialPacker and claim components in
+ * target_id order, while a dedicated sender thread drains finished packets strictly in
+ * target_id order. The queue between them is a fixed ring of queue_depth slots: a worker whose
+ * packet is more than queue_depth ahead of the sender blocks, which bounds memory to roughly
+ * (jobs + queue_depth) packets. Every packet is built by the same packComponent() as the serial
+ * path, so the bytes on the wire are identical.
+ */
+
+/**
+ * Progressive LOD Aura Check:
+ * With --progressive a component leaves as several frames instead of one. The base frame
+ * (file_type 0x03, flag 0x20) carries the topology and only the approximation band; each Haar
+ * detail band then follows as its own file_type 0x04 frame, coarsest first, quantized with its
+ * own per-plane steps. ProgressiveDispatcher sends every component's base frame as soon as it is
+ * built and holds the detail bands back until a window of kProgressiveWindow components has its
+ * bases out, then sends that window's bands coarsest first. Held bands are therefore bounded by
+ * the window rather than the scene; the trade-off is that a scene larger than one window shows
+ * up coarse window by window instead of all at once.
+ * Detail frame payload: [u8 band (1 = coarsest detail)][coefficient stream]
+ */
+
+struct TxSettings {
+    float threshold = 0.01f;
+    int coefficient_bits = CoefficientCodec::kDefaultBits;
+    int levels = 1;
+    bool morton_order = false; // Spatially reorder vertices before the wavelet pass
+    bool progressive = false;  // Split coefficients into a base frame plus one frame per detail band
+
+    // Per-target_id thresholds from RateControl (--max-error / --bitrate). When set, components
+    // arrive already ordered and transformed by prepareComponent and `threshold` is unused.
+    std::vector<PlaneThresholds> plane_thresholds;
+    std::vector<uint64_t> source_hashes; // Per-target_id topology hashes prepareScene took before reordering
+    float delta_max_error = 0.0f; // Error bound session deltas are held to under rate control
+};
+
+constexpr uint8_t kFileTypeSpatial = 0x03;
+constexpr uint8_t kFileTypeDetailBand = 0x04;
+constexpr uint8_t kFlagProgressive = 0x20;
+
+using FrameList = std::vector<std::vector<uint8_t>>;
+using SendFn = std::function<void(const std::vector<uint8_t>&)>;
+
+// Topology order (cache-ordered triangles + first-use vertices, or Morton-ordered vertices).
+// Returns the hash of the source topology, taken before reordering. With a session entry the
+// Morton permutation is computed once and reused while that hash is unchanged, so a moving part
+// keeps its vertex order (and its deltas) instead of forcing a keyframe every pass.
+uint64_t orderComponent(SpatialPacker& packer, MeshData& component, const TxSettings& settings, DeltaSessions::Entry* session);
+
+// Topology order plus the forward wavelet, without thresholding: the scene pre-pass that rate
+// control measures before packComponent runs with settings.plane_thresholds. Returns the source
+// topology hash from orderComponent.
+uint64_t prepareComponent(SpatialPacker& packer, MeshData& component, const TxSettings& settings,
+                          DeltaSessions::Entry* session = nullptr);
+
+// prepareComponent over the whole scene on `jobs` workers; returns the source topology hashes,
+// for settings.source_hashes
+std::vector<uint64_t> prepareScene(std::vector<MeshData>& components, const TxSettings& settings, int jobs,
+                                   DeltaSessions* sessions = nullptr);
+
+// Runs the full TX chain on one component and returns its frames (QuasarHeader + payload each):
+// a single frame, or the base frame followed by detail bands when settings.progressive is set.
+// With `sessions`, the frame is a session keyframe or a delta against the receiver's cache
+// (progressive is ignored in that mode).
+FrameList packComponent(SpatialPacker& packer, MeshData& component, uint32_t target_id, const TxSettings& settings,
+                        DeltaSessions* sessions = nullptr);
+
+constexpr size_t kProgressiveWindow = 64;
+
+// Sends each component's first frame immediately and defers the rest until `window` components
+// have been dispatched (or flush()), then emits them band by band across those components
+class ProgressiveDispatcher {
+public:
+    explicit ProgressiveDispatcher(const SendFn& send, size_t window = kProgressiveWindow)
+        : send_(send), window_(std::max<size_t>(window, 1)) {}
+
+    void dispatch(FrameList&& frames);
+    void flush();
+
+private:
+    SendFn send_;
+    size_t window_;
+    size_t held_ = 0;                 // Components with bands in deferred_
+    std::vector<FrameList> deferred_; // [band - 1][component]
+};
+
+// Bounded reorder buffer: packets go in tagged with their sequence number, come out in sequence
+class OrderedPacketQueue {
+public:
+    explicit OrderedPacketQueue(size_t capacity);
+
+    // Blocks while seq is capacity or more slots ahead of the consumer
+    void push(size_t seq, FrameList&& packet);
+
+    // Blocks until the next packet in sequence is ready
+    FrameList pop();
+
+private:
+    std::mutex mutex_;
+    std::condition_variable space_;
+    std::condition_variable ready_;
+    std::vector<FrameList> slots_;
+    std::vector<bool> filled_;
+    size_t next_ = 0;
+};
+
+class TxPipeline {
+public:
+    TxPipeline(const TxSettings& settings, int jobs, size_t queue_depth, DeltaSessions* sessions = nullptr);
+
+    // Compresses every component and hands the packets to send() in target_id order
+    void run(std::vector<MeshData>& components, const SendFn& send);
+
+private:
+    TxSettings settings_;
+    int jobs_;
+    size_t queue_depth_;
+    DeltaSessions* sessions_;
+};
+
+#endif // TX_PIPELINE_H